@@ -0,0 +1,292 @@
+#!/usr/bin/env python3
+"""
+Latency/throughput benchmark for whisper-stream-stdin
+Replays WAV fixtures through the same stdin path brain_native.py uses and
+reports latency percentiles, real-time factor, peak RSS and WER per model and
+thread count.
+
+Fixtures: a directory of 16 kHz mono 16-bit WAV files, each optionally paired
+with a reference transcript of the same name (meeting.wav -> meeting.txt).
+Utterance ends are found in the fixture audio itself (energy silence detection),
+so latency does not depend on the tool reporting timestamps.
+"""
+
+import argparse
+import array
+import asyncio
+import json
+import math
+import os
+import re
+import sys
+import time
+import wave
+from typing import Dict, List, Optional
+
+from brain_native import AudioPipeline, CognitiveConfig, TranscriptStabilizer
+
+CHUNK_MS = 100
+FRAME_MS = 20
+
+def normalize_words(text: str) -> List[str]:
+    """Lowercase and strip punctuation so WER only counts word errors"""
+    return re.sub(r"[^\w'\s]", " ", text.lower()).split()
+
+def word_error_rate(reference: str, hypothesis: str) -> float:
+    """Word-level Levenshtein distance divided by reference length"""
+    ref = normalize_words(reference)
+    hyp = normalize_words(hypothesis)
+    if not ref:
+        return 0.0 if not hyp else 1.0
+
+    previous = list(range(len(hyp) + 1))
+    for i, ref_word in enumerate(ref, 1):
+        current = [i] + [0] * len(hyp)
+        for j, hyp_word in enumerate(hyp, 1):
+            current[j] = min(previous[j] + 1,
+                             current[j - 1] + 1,
+                             previous[j - 1] + (ref_word != hyp_word))
+        previous = current
+    return previous[-1] / len(ref)
+
+def percentile(values: List[float], pct: float) -> Optional[float]:
+    if not values:
+        return None
+    ordered = sorted(values)
+    index = min(len(ordered) - 1, int(round(pct / 100.0 * (len(ordered) - 1))))
+    return ordered[index]
+
+def read_peak_rss_mb(pid: int) -> Optional[float]:
+    """Peak resident set size of a running child (Linux only)"""
+    try:
+        with open(f"/proc/{pid}/status") as status:
+            for line in status:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1]) / 1024.0
+    except OSError:
+        pass
+    return None
+
+def load_fixture(path: str) -> bytes:
+    with wave.open(path, 'rb') as wav:
+        if wav.getframerate() != 16000 or wav.getnchannels() != 1 or wav.getsampwidth() != 2:
+            raise ValueError(f"{path}: expected 16 kHz mono 16-bit PCM")
+        return wav.readframes(wav.getnframes())
+
+def utterance_ends(pcm: bytes, threshold_db: float, min_silence: float) -> List[float]:
+    """Audio times (s) where speech is followed by at least min_silence of silence, plus the end of trailing speech"""
+    samples = array.array('h', pcm[:len(pcm) - len(pcm) % 2])
+    if sys.byteorder != "little":
+        samples.byteswap()
+    frame = 16000 * FRAME_MS // 1000
+    # Mean square of a full-scale floor at threshold_db
+    floor = (32768.0 * 10 ** (threshold_db / 20.0)) ** 2
+
+    ends: List[float] = []
+    last_speech = None
+    for index in range(0, len(samples) // frame):
+        chunk = samples[index * frame:(index + 1) * frame]
+        energy = sum(x * x for x in chunk) / frame
+        now = index * FRAME_MS / 1000.0
+        if energy >= floor:
+            if last_speech is not None and now - last_speech >= min_silence:
+                ends.append(last_speech)
+            last_speech = now + FRAME_MS / 1000.0
+    if last_speech is not None:
+        ends.append(last_speech)
+    return ends
+
+async def run_fixture(config: CognitiveConfig, pcm: bytes, realtime: bool) -> Dict:
+    """
+    Stream one fixture through whisper-stream-stdin and time every result.
+    An utterance counts as done at the first commit after its end was written
+    that leaves nothing tentative; with input faster than real time that only
+    measures queueing, so latencies are only collected with realtime pacing.
+    """
+    whisper_cmd = AudioPipeline(config)._build_whisper_cmd()
+    proc = await asyncio.create_subprocess_exec(
+        *whisper_cmd,
+        stdin=asyncio.subprocess.PIPE,
+        stdout=asyncio.subprocess.PIPE,
+        stderr=asyncio.subprocess.DEVNULL
+    )
+
+    bytes_per_second = config.sample_rate * 2
+    chunk_bytes = bytes_per_second * CHUNK_MS // 1000
+    # Wall-clock time at which each chunk boundary (in audio seconds) was written
+    written_at: List[float] = []
+    peak_rss = [None]
+    start = time.perf_counter()
+
+    async def feed():
+        for offset in range(0, len(pcm), chunk_bytes):
+            proc.stdin.write(pcm[offset:offset + chunk_bytes])
+            await proc.stdin.drain()
+            written_at.append(time.perf_counter())
+            if realtime:
+                target = start + len(written_at) * CHUNK_MS / 1000.0
+                await asyncio.sleep(max(0.0, target - time.perf_counter()))
+        proc.stdin.close()
+
+    async def sample_rss():
+        while proc.returncode is None:
+            peak_rss[0] = read_peak_rss_mb(proc.pid) or peak_rss[0]
+            await asyncio.sleep(0.2)
+
+    feeder = asyncio.create_task(feed())
+    sampler = asyncio.create_task(sample_rss())
+
+    stabilizer = TranscriptStabilizer(config.transcript_agreement_steps)
+    pipeline = AudioPipeline(config)
+    texts: List[str] = []
+    latencies: List[float] = []
+    first_result = None
+    ends = utterance_ends(pcm, config.vad_threshold_db, config.vad_min_silence) if realtime else []
+    next_end = 0
+
+    def close_utterances(now: float):
+        """Every utterance whose end has been written is now fully committed"""
+        nonlocal next_end
+        while next_end < len(ends):
+            chunk_index = int(ends[next_end] * 1000 // CHUNK_MS)
+            if chunk_index >= len(written_at):
+                break
+            latencies.append((now - written_at[chunk_index]) * 1000)
+            next_end += 1
+
+    while True:
+        line = await proc.stdout.readline()
+        if not line:
+            break
+        now = time.perf_counter()
+        segment = pipeline._parse_output_line(line)
+        if not segment or segment.text in ['[BLANK_AUDIO]', '']:
+            continue
+        if pipeline.guard and pipeline.guard.check(segment):
+            continue
+        if first_result is None:
+            first_result = now - start
+
+        if segment.is_final is None:
+            committed, tentative = stabilizer.update(segment.text)
+        else:
+            committed, tentative = (segment.text, "") if segment.is_final else ("", segment.text)
+        if not committed:
+            continue
+        texts.append(committed)
+        if not tentative:
+            close_utterances(now)
+
+    remainder = stabilizer.flush()
+    if remainder:
+        texts.append(remainder)
+        close_utterances(time.perf_counter())
+    await feeder
+    await proc.wait()
+    sampler.cancel()
+    finished = time.perf_counter()
+
+    audio_seconds = len(pcm) / bytes_per_second
+    return {
+        "text": " ".join(t for t in texts if t),
+        "audio_seconds": audio_seconds,
+        "wall_seconds": finished - start,
+        "rtf": (finished - start) / audio_seconds if audio_seconds else None,
+        "tail_latency_ms": (finished - written_at[-1]) * 1000 if written_at else None,
+        "first_result_ms": first_result * 1000 if first_result is not None else None,
+        "latencies_ms": latencies,
+        "utterances": len(ends),
+        "peak_rss_mb": peak_rss[0],
+    }
+
+def format_ms(value: Optional[float]) -> str:
+    return f"{value:.0f}" if value is not None else "-"
+
+async def main():
+    parser = argparse.ArgumentParser(description="Benchmark whisper-stream-stdin on canned audio")
+    parser.add_argument("--fixtures", required=True,
+                       help="Directory of 16 kHz mono WAV files with optional .txt references")
+    parser.add_argument("--models", nargs="+", default=[CognitiveConfig.whisper_model],
+                       help="Model files to benchmark (e.g. tiny.en through large-v3)")
+    parser.add_argument("--threads", nargs="+", type=int, default=[CognitiveConfig.whisper_threads],
+                       help="Thread counts to benchmark")
+    parser.add_argument("--executable", default=CognitiveConfig.whisper_executable,
+                       help="Path to whisper-stream-stdin")
+    parser.add_argument("--output-format", choices=["text", "ndjson"], default="text",
+                       help="Tool output format")
+    parser.add_argument("--realtime", action="store_true",
+                       help="Pace input at real time instead of as fast as possible (needed for latency)")
+    parser.add_argument("--json-out", help="Also write raw results to this JSON file")
+
+    args = parser.parse_args()
+
+    fixtures = sorted(f for f in os.listdir(args.fixtures) if f.lower().endswith(".wav"))
+    if not fixtures:
+        print(f"❌ No WAV fixtures found in {args.fixtures}")
+        return False
+
+    print("🚀 whisper-stream-stdin benchmark")
+    print(f"   Fixtures: {len(fixtures)}  Mode: {'real-time' if args.realtime else 'as fast as possible'}")
+    print("=" * 96)
+    print(f"{'model':<32} {'thr':>3} {'RTF':>6} {'p50':>6} {'p90':>6} {'p99':>6} "
+          f"{'tail':>6} {'RSS MB':>7} {'WER':>6}")
+
+    results = []
+    for model in args.models:
+        for threads in args.threads:
+            config = CognitiveConfig(whisper_model=model, whisper_executable=args.executable,
+                                     whisper_threads=threads)
+            config.whisper_output_format = args.output_format
+
+            runs = []
+            for name in fixtures:
+                path = os.path.join(args.fixtures, name)
+                run = await run_fixture(config, load_fixture(path), args.realtime)
+                reference_path = os.path.splitext(path)[0] + ".txt"
+                if os.path.exists(reference_path):
+                    with open(reference_path, encoding="utf-8") as ref:
+                        run["wer"] = word_error_rate(ref.read(), run["text"])
+                run["fixture"] = name
+                runs.append(run)
+
+            latencies = [l for run in runs for l in run["latencies_ms"]]
+            audio = sum(run["audio_seconds"] for run in runs)
+            wall = sum(run["wall_seconds"] for run in runs)
+            wers = [run["wer"] for run in runs if "wer" in run]
+            rss = [run["peak_rss_mb"] for run in runs if run["peak_rss_mb"] is not None]
+            tails = [run["tail_latency_ms"] for run in runs if run["tail_latency_ms"] is not None]
+            summary = {
+                "model": model,
+                "threads": threads,
+                "rtf": wall / audio if audio else None,
+                "p50_ms": percentile(latencies, 50),
+                "p90_ms": percentile(latencies, 90),
+                "p99_ms": percentile(latencies, 99),
+                "tail_p50_ms": percentile(tails, 50),
+                "peak_rss_mb": max(rss) if rss else None,
+                "wer": sum(wers) / len(wers) if wers else None,
+                "runs": runs,
+            }
+            results.append(summary)
+
+            rss_text = f"{summary['peak_rss_mb']:.0f}" if summary['peak_rss_mb'] else "-"
+            wer_text = f"{summary['wer']:.1%}" if summary['wer'] is not None else "-"
+            print(f"{os.path.basename(model):<32} {threads:>3} "
+                  f"{summary['rtf']:>6.2f} {format_ms(summary['p50_ms']):>6} "
+                  f"{format_ms(summary['p90_ms']):>6} {format_ms(summary['p99_ms']):>6} "
+                  f"{format_ms(summary['tail_p50_ms']):>6} {rss_text:>7} {wer_text:>6}")
+
+    print("=" * 96)
+    if not args.realtime:
+        print("ℹ️  Latency percentiles need --realtime; unpaced input only measures queueing")
+
+    if args.json_out:
+        with open(args.json_out, "w", encoding="utf-8") as out:
+            json.dump(results, out, indent=2)
+        print(f"📄 Raw results written to {args.json_out}")
+
+    return True
+
+if __name__ == "__main__":
+    ok = asyncio.run(main())
+    sys.exit(0 if ok else 1)
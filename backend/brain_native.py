@@ -6,14 +6,19 @@ Eliminates C++ WebSocket server entirely and uses robust subprocess management
 
 import asyncio
 import aiohttp
+from aiohttp import web
 import json
 import re
 import time
 import logging
+import zlib
+import inspect
+import tracemalloc
 import os
+import sys
 from collections import deque
 from dataclasses import dataclass
-from typing import Optional, Dict, Any, Set
+from typing import Optional, Dict, Any, Set, List, Tuple
 import argparse
 import websockets
 import signal
@@ -25,6 +30,72 @@ logging.basicConfig(
 )
 logger = logging.getLogger('cognitive_engine_native')
 
+def resolve_quantized_model(path: str, quantization: str) -> str:
+    """Prefer a quantized sibling of path (ggml-base.en.bin -> ggml-base.en-q5_1.bin) when one exists"""
+    root, ext = os.path.splitext(path)
+    if re.search(r'-q\d_\d$', root):
+        return path
+    for quant in filter(None, (q.strip() for q in quantization.split(','))):
+        candidate = f"{root}-{quant}{ext}"
+        if os.path.exists(candidate):
+            return candidate
+    return path
+
+def parse_cpu_list(spec: str) -> List[int]:
+    """Parse a core list like "4-11,14" into [4, 5, ..., 11, 14]"""
+    cpus = []
+    for part in filter(None, (p.strip() for p in spec.split(','))):
+        if '-' in part:
+            first, last = part.split('-', 1)
+            cpus.extend(range(int(first), int(last) + 1))
+        else:
+            cpus.append(int(part))
+    return sorted(set(cpus))
+
+def apply_process_placement(pid: int, cpus: List[int], below_normal: bool = False):
+    """
+    Pin a process to a core set and optionally lower its priority.
+    Uses sched_setaffinity/setpriority on POSIX and SetProcessAffinityMask/
+    SetPriorityClass on Windows; unsupported platforms are left untouched.
+    """
+    if os.name == 'nt':
+        import ctypes
+        PROCESS_SET_INFORMATION = 0x0200
+        PROCESS_QUERY_INFORMATION = 0x0400
+        BELOW_NORMAL_PRIORITY_CLASS = 0x4000
+        kernel32 = ctypes.windll.kernel32
+        handle = kernel32.OpenProcess(PROCESS_SET_INFORMATION | PROCESS_QUERY_INFORMATION, False, pid)
+        if not handle:
+            raise OSError(f"OpenProcess failed for PID {pid}")
+        try:
+            if cpus and not kernel32.SetProcessAffinityMask(handle, ctypes.c_size_t(sum(1 << c for c in cpus))):
+                raise OSError(f"SetProcessAffinityMask failed for PID {pid}")
+            if below_normal:
+                kernel32.SetPriorityClass(handle, BELOW_NORMAL_PRIORITY_CLASS)
+        finally:
+            kernel32.CloseHandle(handle)
+        return
+
+    if cpus and hasattr(os, 'sched_setaffinity'):
+        os.sched_setaffinity(pid, cpus)
+    if below_normal and hasattr(os, 'setpriority'):
+        os.setpriority(os.PRIO_PROCESS, pid, 5)
+
+def current_process_affinity() -> List[int]:
+    """Cores this process may run on, or [] where that cannot be read"""
+    if os.name == 'nt':
+        import ctypes
+        process_mask = ctypes.c_size_t()
+        system_mask = ctypes.c_size_t()
+        kernel32 = ctypes.windll.kernel32
+        if not kernel32.GetProcessAffinityMask(kernel32.GetCurrentProcess(),
+                                               ctypes.byref(process_mask), ctypes.byref(system_mask)):
+            return []
+        return [c for c in range(process_mask.value.bit_length()) if process_mask.value >> c & 1]
+    if hasattr(os, 'sched_getaffinity'):
+        return sorted(os.sched_getaffinity(0))
+    return []
+
 @dataclass
 class CognitiveConfig:
     """Configuration for the Native Cognitive Engine"""
@@ -38,28 +109,186 @@ class CognitiveConfig:
 
     # Audio processing configuration
     audio_device: str = "CABLE Output (VB-Audio Virtual Cable)"
+    # Optional second capture for the local microphone, transcribed as its own stream
+    mic_device: Optional[str] = None
     sample_rate: int = 16000
     channels: int = 1
+    # Ask DirectShow to deliver 16 kHz mono s16 directly, so ffmpeg's resampler
+    # becomes a pass-through instead of a per-sample 48k stereo -> 16k mono stage
+    capture_device_format: bool = False
+    # ffmpeg input device: "dshow" (Windows), "avfoundation" (macOS/CoreAudio),
+    # "pulse" (Linux); empty picks the platform default
+    capture_backend: str = ""
+    # Device buffer period; DirectShow's default is several hundred ms (0 keeps it)
+    capture_buffer_ms: int = 50
+
+    # Energy VAD gate (ffmpeg silenceremove): silence longer than vad_min_silence
+    # never reaches whisper, so no whisper_full pass is spent on it
+    vad_enabled: bool = True
+    vad_threshold_db: float = -45.0
+    vad_min_silence: float = 0.6
+    vad_keep_silence: float = 0.3
+    # Silence fed to whisper once the gate closes, so its window still decodes
+    # the last words of an utterance; what is then still tentative is committed
+    vad_tail_seconds: float = 1.5
 
     # Whisper CLI configuration
     whisper_model: str = "whisper.cpp/models/for-tests-ggml-tiny.en.bin"
     whisper_executable: str = "whisper.cpp/build/bin/Release/whisper-stream-stdin.exe"
     whisper_threads: int = 4
+    # Quantized variants the engine tries first, in order (prefer_quantized_models);
+    # empty loads whisper_model as given. Tools run the model files they are given
+    whisper_quantization: str = "q5_1,q8_0"
+    # Smaller models to step down to, in order, when the real-time factor stays
+    # above rtf_downgrade_threshold; swapped in without dropping the stream
+    whisper_fallback_models: list = None
+    rtf_downgrade_threshold: float = 1.0
+    rtf_window_seconds: float = 10.0
+    model_load_timeout: float = 60.0
+    # "text" (one plain line per result) or "ndjson" (one TranscriptSegment object per line)
+    whisper_output_format: str = "text"
+    # Decode language. "auto" detects on the first confident ndjson segments,
+    # then pins the stream to that language (-l xx) so detection stops running
+    # every window; low-confidence decoding releases it back to auto.
+    whisper_language: str = "en"
+    # Languages "auto" may pin to (empty allows any)
+    whisper_languages: list = None
+    # Extra whisper-stream-stdin arguments per pinned language, e.g. a
+    # suppress-token set: {"de": ["--suppress-regex", "..."]}
+    whisper_language_args: dict = None
+    language_lock_prob: float = 0.8
+    language_lock_segments: int = 2
+    language_release_logprob: float = -1.0
+    language_release_segments: int = 3
+
+    # Capture relay: ffmpeg output is buffered here so capture never waits on decoding
+    audio_buffer_seconds: float = 10.0
+    audio_read_chunk_bytes: int = 4096
+    capture_restart_delay: float = 1.0
+    # Latency bound: when whisper falls this far behind, the oldest buffered
+    # audio is skipped down to backlog_skip_to_seconds and reported as a gap
+    # (0 disables; the ring then only drops on overflow)
+    max_backlog_seconds: float = 3.0
+    backlog_skip_to_seconds: float = 0.5
+
+    # Core placement: whisper gets the compute cores; ffmpeg capture and this
+    # process (ring relay, Advisor) stay on the capture cores so they never
+    # preempt inference. Empty lists inherit the parent's affinity.
+    compute_cpus: list = None
+    capture_cpus: list = None
+    # Run whisper below normal priority so capture always wins a contended core
+    lower_compute_priority: bool = False
+
+    # Hallucination guard: segments that look like decoder loops or silence
+    # hallucinations are dropped before they reach the stabilizer or the Advisor
+    hallucination_guard: bool = True
+    hallucination_phrases: list = None
+    # Same thresholds whisper uses for its temperature fallback
+    compression_ratio_threshold: float = 2.4
+    no_speech_threshold: float = 0.6
+    logprob_threshold: float = -1.0
+    # A word n-gram (n = 1..8) repeated this many times back to back, covering
+    # at least 8 words, is a decoder loop
+    max_ngram_repeats: int = 3
+    # A stock phrase ("Thank you.") is only dropped when the tool scores it low,
+    # or, without scores, when it is all that was heard after this long a quiet
+    hallucination_gap_seconds: float = 2.0
+
+    # Transcript stabilization: words are committed once N consecutive window
+    # hypotheses agree on them (LocalAgreement); 1 commits every line immediately
+    transcript_agreement_steps: int = 2
+
+    # Prometheus-style /metrics endpoint (0 disables)
+    metrics_port: int = 9083
+    # Debug leak check: trace allocations and report memory the audio relay is
+    # still holding that it allocated after alloc_debug_warmup seconds (should
+    # stay zero). Short-lived per-chunk objects are freed at once and not counted
+    alloc_debug: bool = False
+    alloc_debug_warmup: float = 30.0
+
+    # Session recording: unfiltered capture audio as FLAC chunks plus an NDJSON
+    # time index of committed segments, one subdirectory per session (empty disables)
+    recording_dir: str = ""
+    recording_chunk_seconds: int = 10
+
+    # Frontend fan-out: per-client send queue bound and burst coalescing tick
+    ws_client_queue_size: int = 64
+    ws_coalesce_ms: float = 20.0
 
     # Chronicler settings
     context_max_length: int = 50
     summarization_timer: float = 5.0
+    # Whole-meeting transcript memory: every context item is indexed and the
+    # Advisor gets the top-k items most relevant to the question
+    transcript_index_max_items: int = 20000
+    context_retrieval_k: int = 3
+    # Share of max_context_tokens kept for those items, so recent text and the
+    # summary cannot crowd them out (unused room goes back to recent text)
+    context_retrieval_share: float = 0.4
+    # Rolling summary: new context items are folded in by the Advisor model once
+    # they exceed this many characters
+    summary_token_budget: int = 1200
+    summary_timeout: float = 15.0
 
     # Advisor settings
     advisor_model: str = "llama3:8b"
+    # Start the Advisor call on tentative question text; the result is used if the
+    # committed text turns out to be the same question, otherwise it is cancelled
+    speculative_advisor: bool = True
+    # Questions asked by our own user are not answered: everything on the local
+    # mic stream, plus any diarized speaker ids listed here
+    answer_local_questions: bool = False
+    self_speakers: list = None
+    speculation_max_age: float = 5.0
     question_patterns: list = None
     advisor_timeout: float = 0.7
+    # How long Ollama keeps the Advisor model (and its prompt cache) resident
+    advisor_keep_alive: str = "30m"
     max_context_tokens: int = 300
 
     def __post_init__(self):
         # Environment variable overrides
         self.advisor_model = os.getenv('COPILOT_ADVISOR_MODEL', self.advisor_model)
         self.chronicler_enabled = os.getenv('COPILOT_CHRONICLER_ENABLED', 'true').lower() == 'true'
+        self.capture_device_format = os.getenv(
+            'COPILOT_CAPTURE_DEVICE_FORMAT', str(self.capture_device_format)).lower() == 'true'
+        self.whisper_quantization = os.getenv('COPILOT_WHISPER_QUANT', self.whisper_quantization)
+        if self.whisper_fallback_models is None:
+            fallback = os.getenv('COPILOT_WHISPER_FALLBACK_MODELS', '')
+            self.whisper_fallback_models = [m.strip() for m in fallback.split(',') if m.strip()]
+        self.whisper_output_format = os.getenv('COPILOT_WHISPER_OUTPUT', self.whisper_output_format).lower()
+        self.whisper_language = os.getenv('COPILOT_WHISPER_LANGUAGE', self.whisper_language).lower()
+        if self.whisper_languages is None:
+            languages = os.getenv('COPILOT_WHISPER_LANGUAGES', '')
+            self.whisper_languages = [l.strip().lower() for l in languages.split(',') if l.strip()]
+        if self.whisper_language_args is None:
+            self.whisper_language_args = {}
+        if self.self_speakers is None:
+            speakers = os.getenv('COPILOT_SELF_SPEAKERS', '')
+            self.self_speakers = [sp.strip() for sp in speakers.split(',') if sp.strip()]
+        if self.compute_cpus is None:
+            self.compute_cpus = parse_cpu_list(os.getenv('COPILOT_COMPUTE_CPUS', ''))
+        if self.capture_cpus is None:
+            self.capture_cpus = parse_cpu_list(os.getenv('COPILOT_CAPTURE_CPUS', ''))
+        self.lower_compute_priority = os.getenv(
+            'COPILOT_LOWER_COMPUTE_PRIORITY', str(self.lower_compute_priority)).lower() == 'true'
+        self.mic_device = os.getenv('COPILOT_MIC_DEVICE', self.mic_device) or None
+        self.metrics_port = int(os.getenv('COPILOT_METRICS_PORT', self.metrics_port))
+        self.capture_backend = os.getenv('COPILOT_CAPTURE_BACKEND', self.capture_backend)
+        if not self.capture_backend:
+            self.capture_backend = {"win32": "dshow", "darwin": "avfoundation"}.get(sys.platform, "pulse")
+        self.capture_buffer_ms = int(os.getenv('COPILOT_CAPTURE_BUFFER_MS', self.capture_buffer_ms))
+        self.vad_enabled = os.getenv('COPILOT_VAD_ENABLED', str(self.vad_enabled)).lower() == 'true'
+        self.vad_tail_seconds = float(os.getenv('COPILOT_VAD_TAIL_SECONDS', self.vad_tail_seconds))
+        self.recording_dir = os.getenv('COPILOT_RECORDING_DIR', self.recording_dir)
+        self.alloc_debug = os.getenv('COPILOT_ALLOC_DEBUG', str(self.alloc_debug)).lower() == 'true'
+
+        if self.hallucination_phrases is None:
+            self.hallucination_phrases = [
+                "thank you", "thanks for watching", "thank you for watching",
+                "please subscribe", "subscribe to my channel", "you", "bye",
+                "[music]", "(music)", "[applause]", "[silence]",
+            ]
 
         if self.question_patterns is None:
             self.question_patterns = [
@@ -72,18 +301,237 @@ class CognitiveConfig:
 
         logger.info(f"🔧 Native Config: Advisor model={self.advisor_model}")
         logger.info(f"🔧 Audio device: {self.audio_device}")
+        if self.mic_device:
+            logger.info(f"🔧 Microphone device: {self.mic_device}")
         logger.info(f"🔧 Whisper model: {self.whisper_model}")
+        if self.compute_cpus or self.capture_cpus:
+            logger.info(f"🔧 Compute cores: {self.compute_cpus or 'inherited'}, "
+                        f"capture cores: {self.capture_cpus or 'inherited'}")
+            if self.compute_cpus and self.whisper_threads > len(self.compute_cpus):
+                logger.warning(f"whisper_threads={self.whisper_threads} exceeds the "
+                               f"{len(self.compute_cpus)} compute cores; threads will contend")
+        if self.whisper_fallback_models:
+            logger.info(f"🔧 Whisper fallback models: {', '.join(self.whisper_fallback_models)}")
+        if self.whisper_language == "auto":
+            if self.whisper_output_format != "ndjson":
+                logger.warning("whisper_language=auto needs ndjson output to pin a language; "
+                               "detection will run on every window")
+            if ".en" in os.path.basename(self.whisper_model):
+                logger.warning(f"whisper_language=auto with English-only model {self.whisper_model}")
+
+    def prefer_quantized_models(self):
+        """Engine startup: swap in quantized siblings of the configured models where they exist"""
+        model = resolve_quantized_model(self.whisper_model, self.whisper_quantization)
+        if model != self.whisper_model:
+            logger.info(f"🔧 Using quantized Whisper model: {model}")
+            self.whisper_model = model
+        self.whisper_fallback_models = [resolve_quantized_model(m, self.whisper_quantization)
+                                        for m in self.whisper_fallback_models]
+
+    def audio_streams(self) -> List[Tuple[str, str]]:
+        """(stream_id, device) pairs to transcribe: remote participants first, then the local mic"""
+        streams = [("remote", self.audio_device)]
+        if self.mic_device:
+            streams.append(("local", self.mic_device))
+        return streams
+
+class LatencyHistogram:
+    """Cumulative-bucket histogram of milliseconds, one series per label set"""
+
+    BUCKETS_MS = (1, 2.5, 5, 10, 25, 50, 100, 250, 500, 1000, 2500, 5000, 10000)
+
+    def __init__(self, name: str, help_text: str, buckets: Tuple[float, ...] = BUCKETS_MS):
+        self.name = name
+        self.help_text = help_text
+        self.buckets = buckets
+        # labels -> [per-bucket counts..., +Inf count], sum
+        self.series: Dict[Tuple[Tuple[str, str], ...], list] = {}
+
+    def _series(self, labels: Dict[str, str]) -> list:
+        key = tuple(sorted(labels.items()))
+        series = self.series.get(key)
+        if series is None:
+            series = self.series[key] = [[0] * (len(self.buckets) + 1), 0.0]
+        return series
+
+    def observe(self, value_ms: float, **labels):
+        self.record(self._series(labels), value_ms)
+
+    def bind(self, **labels):
+        """Observer for one fixed label set; the hot path then builds no label key per call"""
+        series = self._series(labels)
+        return lambda value_ms: self.record(series, value_ms)
+
+    def record(self, series: list, value_ms: float):
+        counts = series[0]
+        for i, bound in enumerate(self.buckets):
+            if value_ms <= bound:
+                counts[i] += 1
+                break
+        else:
+            counts[-1] += 1
+        series[1] += value_ms
+
+    def render(self) -> List[str]:
+        lines = [f"# HELP {self.name} {self.help_text}", f"# TYPE {self.name} histogram"]
+        for key, (counts, total) in self.series.items():
+            labels = ",".join(f'{k}="{v}"' for k, v in key)
+            prefix = labels + "," if labels else ""
+            cumulative = 0
+            for bound, count in zip(self.buckets, counts):
+                cumulative += count
+                lines.append(f'{self.name}_bucket{{{prefix}le="{bound}"}} {cumulative}')
+            cumulative += counts[-1]
+            lines.append(f'{self.name}_bucket{{{prefix}le="+Inf"}} {cumulative}')
+            suffix = f"{{{labels}}}" if labels else ""
+            lines.append(f"{self.name}_sum{suffix} {total:.3f}")
+            lines.append(f"{self.name}_count{suffix} {cumulative}")
+        return lines
+
+class PipelineMetrics:
+    """
+    Per-stage latency histograms for the transcription path, rendered in the
+    Prometheus text format. Stages measured in Python (pipe waits, ring depth,
+    advisor) are observed directly; stages inside whisper-stream-stdin (mel,
+    encoder, decoder, first token) come from its NDJSON segment and stats frames.
+    """
+
+    STAGES = {
+        "pipe_read_wait": "Time waiting on the ffmpeg stdout pipe per read",
+        "whisper_write_wait": "Time blocked writing PCM into whisper-stream-stdin",
+        "ring_depth": "Buffered audio in the capture ring, sampled per write",
+        "mel": "Log-mel computation per step (reported by whisper-stream-stdin)",
+        "encode": "Encoder time per step (reported by whisper-stream-stdin)",
+        "decode": "Decoder time per step (reported by whisper-stream-stdin)",
+        "first_token": "Time to first decoded token per step (reported by whisper-stream-stdin)",
+        "advisor": "Question to Advisor response latency",
+    }
+
+    def __init__(self):
+        self.histograms = {stage: LatencyHistogram(f"earshot_{stage}_ms", help_text)
+                           for stage, help_text in self.STAGES.items()}
+        self.counters: Dict[str, Tuple[str, Any]] = {}
+
+    def observe(self, stage: str, value_ms: Optional[float], **labels):
+        if value_ms is not None:
+            self.histograms[stage].observe(value_ms, **labels)
+
+    def bind(self, stage: str, **labels):
+        return self.histograms[stage].bind(**labels)
+
+    def counter(self, name: str, help_text: str, read):
+        """Register a counter whose value is read at scrape time; read() returns {stream: value}"""
+        self.counters[name] = (help_text, read)
+
+    def render(self) -> str:
+        lines = []
+        for histogram in self.histograms.values():
+            lines += histogram.render()
+        for name, (help_text, read) in self.counters.items():
+            lines += [f"# HELP {name} {help_text}", f"# TYPE {name} counter"]
+            for stream_id, value in read().items():
+                lines.append(f'{name}{{stream="{stream_id}"}} {value}')
+        return "\n".join(lines) + "\n"
+
+class ClientChannel:
+    """
+    Bounded send queue for one frontend client, drained by its own task so a
+    slow HUD only ever delays itself. Full messages arrive pre-serialized;
+    partial transcripts are kept as text, and a newer partial for the same
+    stream replaces a queued one. Partials are delta-encoded against what this
+    client was last sent.
+    """
+
+    def __init__(self, websocket, max_queue: int, coalesce_ms: float):
+        self.websocket = websocket
+        self.max_queue = max(1, max_queue)
+        self.coalesce = coalesce_ms / 1000.0
+        # (partial stream id or None, serialized message or partial text, final stream id or None)
+        self.queue: deque = deque()
+        self.wakeup = asyncio.Event()
+        # Opt-in: existing clients never see transcript_partial frames
+        self.partials = False
+        self.partial_base: Dict[str, str] = {}
+        self.dropped = 0
+        self.task: Optional[asyncio.Task] = None
+
+    def push(self, message: str, final_stream: Optional[str] = None):
+        if len(self.queue) >= self.max_queue:
+            self._evict()
+        self.queue.append((None, message, final_stream))
+        self.wakeup.set()
+
+    def push_partial(self, stream_id: str, text: str):
+        if not self.partials:
+            return
+        for i, (key, _, _) in enumerate(self.queue):
+            if key == stream_id:
+                del self.queue[i]
+                self.dropped += 1
+                break
+        if len(self.queue) >= self.max_queue:
+            self._evict()
+        self.queue.append((stream_id, text, None))
+        self.wakeup.set()
+
+    def _evict(self):
+        # Stale partials go first; a client that far behind loses its oldest message
+        for i, (key, _, _) in enumerate(self.queue):
+            if key is not None:
+                del self.queue[i]
+                break
+        else:
+            self.queue.popleft()
+        self.dropped += 1
+
+    def _encode_partial(self, stream_id: str, text: str) -> str:
+        base = self.partial_base.get(stream_id, "")
+        keep = 0
+        for a, b in zip(base, text):
+            if a != b:
+                break
+            keep += 1
+        self.partial_base[stream_id] = text
+        return json.dumps({
+            "type": "transcript_partial",
+            "stream": stream_id,
+            "keep": keep,
+            "text": text[keep:],
+            "timestamp": int(time.time() * 1000)
+        })
+
+    async def run(self):
+        while True:
+            await self.wakeup.wait()
+            # Let a burst collapse into one send per stream before draining
+            if self.coalesce:
+                await asyncio.sleep(self.coalesce)
+            self.wakeup.clear()
+            while self.queue:
+                key, payload, final_stream = self.queue.popleft()
+                if key is not None:
+                    payload = self._encode_partial(key, payload)
+                elif final_stream is not None:
+                    # The client drops its partial for the stream when the final text arrives
+                    self.partial_base.pop(final_stream, None)
+                await self.websocket.send(payload)
 
 class FrontendWebSocketServer:
     """
-    WebSocket server for frontend communication (unchanged from original)
+    WebSocket server for frontend communication. Every event is serialized
+    once and handed to per-client ClientChannel queues; no broadcast awaits a
+    client.
     """
 
     def __init__(self, config: CognitiveConfig):
         self.config = config
-        self.clients: Set[websockets.WebSocketServerProtocol] = set()
+        self.clients: Dict[websockets.WebSocketServerProtocol, ClientChannel] = {}
         self.server = None
         self.is_paused = False
+        # Engine hook for control messages (e.g. model swaps); set by NativeCognitiveEngine
+        self.control_handler = None
+        # Messages dropped from client queues, including replaced partials
+        self.dropped_messages = 0
 
         logger.info(f"Frontend WebSocket server initialized on {config.frontend_ws_host}:{config.frontend_ws_port}")
 
@@ -105,17 +553,14 @@ class FrontendWebSocketServer:
     async def handle_client(self, websocket: websockets.WebSocketServerProtocol):
         """Handle new client connection"""
         client_addr = f"{websocket.remote_address[0]}:{websocket.remote_address[1]}"
+        channel = ClientChannel(websocket, self.config.ws_client_queue_size, self.config.ws_coalesce_ms)
+        channel.task = asyncio.create_task(self._run_channel(channel, client_addr))
         try:
             logger.info(f"🔌 Frontend client connected: {client_addr}")
-            self.clients.add(websocket)
+            self.clients[websocket] = channel
 
             # Send initial status
-            await self.send_to_client(websocket, {
-                "type": "status",
-                "status": "connected",
-                "paused": self.is_paused,
-                "timestamp": int(time.time() * 1000)
-            })
+            self.send_to_client(websocket, self._status_message())
 
             # Handle messages
             while True:
@@ -136,36 +581,73 @@ class FrontendWebSocketServer:
         except Exception:
             logger.exception("❌ Unhandled error in WebSocket handler")
         finally:
-            self.clients.discard(websocket)
+            self._drop_client(websocket)
+
+    async def _run_channel(self, channel: ClientChannel, client_addr: str):
+        try:
+            await channel.run()
+        except asyncio.CancelledError:
+            pass
+        except websockets.exceptions.ConnectionClosed:
+            pass
+        except Exception as e:
+            logger.error(f"Error sending to client {client_addr}: {e}")
+        finally:
+            self._drop_client(channel.websocket)
+
+    def _drop_client(self, websocket):
+        channel = self.clients.pop(websocket, None)
+        if channel:
+            self.dropped_messages += channel.dropped
+            if channel.task and channel.task is not asyncio.current_task():
+                channel.task.cancel()
+
+    def _status_message(self) -> Dict[str, Any]:
+        return {
+            "type": "status",
+            "status": "connected",
+            "paused": self.is_paused,
+            "timestamp": int(time.time() * 1000)
+        }
 
     async def handle_client_message(self, websocket: websockets.WebSocketServerProtocol, data: Dict[str, Any]):
         """Handle incoming messages from frontend clients"""
         msg_type = data.get('type')
 
         if msg_type == 'ping':
-            await self.send_to_client(websocket, {
+            self.send_to_client(websocket, {
                 "type": "pong",
                 "timestamp": int(time.time() * 1000)
             })
         elif msg_type == 'pause':
             self.is_paused = True
-            await self.broadcast_status()
+            self.broadcast_status()
             logger.info("🚫 System paused by frontend")
         elif msg_type == 'resume':
             self.is_paused = False
-            await self.broadcast_status()
+            self.broadcast_status()
             logger.info("▶️ System resumed by frontend")
-
-    async def send_to_client(self, websocket: websockets.WebSocketServerProtocol, data: Dict[str, Any]):
-        """Send data to a specific client"""
-        try:
-            message = json.dumps(data)
-            await websocket.send(message)
-        except websockets.exceptions.ConnectionClosed:
-            self.clients.discard(websocket)
-        except Exception as e:
-            logger.error(f"Error sending to client: {e}")
-            self.clients.discard(websocket)
+        elif msg_type == 'subscribe':
+            channel = self.clients.get(websocket)
+            if channel:
+                channel.partials = bool(data.get('partials', False))
+        elif msg_type == 'swap_model' and self.control_handler:
+            await self.control_handler(data)
+
+    def send_to_client(self, websocket: websockets.WebSocketServerProtocol, data: Dict[str, Any]):
+        """Queue data for a specific client"""
+        channel = self.clients.get(websocket)
+        if channel:
+            channel.push(json.dumps(data))
+
+    def _broadcast(self, data: Dict[str, Any], final_stream: Optional[str] = None) -> int:
+        """Serialize once and queue for every client; returns the number of clients"""
+        if not self.clients:
+            return 0
+        message = json.dumps(data)
+        for channel in self.clients.values():
+            channel.push(message, final_stream)
+        return len(self.clients)
 
     async def broadcast_advisor_keywords(self, text: str):
         """Broadcast advisor keywords to all connected clients"""
@@ -173,70 +655,170 @@ class FrontendWebSocketServer:
             logger.debug("System paused, not broadcasting")
             return
 
-        if not self.clients:
-            return
-
-        message = {
+        sent = self._broadcast({
             "type": "advisor_keywords",
             "text": text,
             "timestamp": int(time.time() * 1000)
-        }
-
-        disconnected = set()
-        for client in self.clients:
-            try:
-                await self.send_to_client(client, message)
-            except Exception:
-                disconnected.add(client)
-
-        self.clients -= disconnected
-
-        if self.clients:
-            logger.info(f"🎯 Broadcast to {len(self.clients)} client(s): {text}")
+        })
+        if sent:
+            logger.info(f"🎯 Broadcast to {sent} client(s): {text}")
 
-    async def broadcast_status(self):
-        """Broadcast current system status to all clients"""
-        if not self.clients:
+    def broadcast_transcript(self, text: str, stream_id: str, speaker: Optional[str] = None):
+        """Committed transcript text; ends any partial the clients show for the stream"""
+        if self.is_paused:
             return
+        self._broadcast({
+            "type": "transcript",
+            "text": text,
+            "stream": stream_id,
+            "speaker": speaker,
+            "timestamp": int(time.time() * 1000)
+        }, final_stream=stream_id)
 
-        message = {
-            "type": "status",
-            "status": "connected",
-            "paused": self.is_paused,
+    def broadcast_partial(self, text: str, stream_id: str):
+        """Tentative transcript text, for clients that subscribed to partials"""
+        if self.is_paused:
+            return
+        for channel in self.clients.values():
+            channel.push_partial(stream_id, text)
+
+    def broadcast_gap(self, stream_id: str, skipped_ms: int):
+        """Tell clients a stretch of audio was skipped and has no transcript"""
+        self._broadcast({
+            "type": "gap",
+            "stream": stream_id,
+            "skipped_ms": skipped_ms,
             "timestamp": int(time.time() * 1000)
-        }
+        })
 
-        for client in list(self.clients):
-            await self.send_to_client(client, message)
+    def broadcast_status(self):
+        """Broadcast current system status to all clients"""
+        self._broadcast(self._status_message())
 
     async def stop_server(self):
         """Stop the WebSocket server"""
+        for websocket in list(self.clients):
+            self._drop_client(websocket)
         if self.server:
             self.server.close()
             await self.server.wait_closed()
             logger.info("🌐 Frontend WebSocket server stopped")
 
+class TranscriptIndex:
+    """
+    Append-only log of every context item in the meeting with an inverted
+    keyword index, so the Advisor can pull relevant past items without
+    keeping the whole transcript in the prompt. Bounded: once max_items is
+    exceeded the oldest quarter is dropped and its postings compacted away.
+    """
+
+    STOPWORDS = frozenset(
+        "a an and are as at be but by can could did do does for from had has have how "
+        "i if in is it its me my of on or our so that the their them then there these "
+        "they this to us was we were what when where which who why will with would you your".split())
+
+    def __init__(self, max_items: int = 20000):
+        self.max_items = max(4, max_items)
+        self.items: List[Dict[str, Any]] = []
+        # Absolute id of items[0]; ids stay stable across compaction
+        self.base = 0
+        self.postings: Dict[str, List[int]] = {}
+
+    @classmethod
+    def _terms(cls, text: str) -> List[str]:
+        return [w for w in re.findall(r"[\w']+", text.lower())
+                if len(w) > 1 and w not in cls.STOPWORDS]
+
+    def __len__(self) -> int:
+        return len(self.items)
+
+    def append(self, item: Dict[str, Any]) -> int:
+        item_id = self.base + len(self.items)
+        self.items.append(item)
+        for term in set(self._terms(item['text'])):
+            self.postings.setdefault(term, []).append(item_id)
+
+        if len(self.items) > self.max_items:
+            self._compact(len(self.items) // 4)
+        return item_id
+
+    def _compact(self, drop: int):
+        self.items = self.items[drop:]
+        self.base += drop
+        for term in list(self.postings):
+            ids = self.postings[term]
+            # Postings are in id order, so everything evicted is a prefix
+            keep = next((i for i, item_id in enumerate(ids) if item_id >= self.base), len(ids))
+            if keep == len(ids):
+                del self.postings[term]
+            elif keep:
+                self.postings[term] = ids[keep:]
+
+    def search(self, query: str, k: int = 3) -> List[Dict[str, Any]]:
+        """Top-k items by idf-weighted term overlap with the query, best first"""
+        if not self.items or k <= 0:
+            return []
+
+        scores: Dict[int, float] = {}
+        for term in set(self._terms(query)):
+            ids = self.postings.get(term)
+            if not ids:
+                continue
+            # Rare terms carry the signal; words in most items carry almost none
+            weight = 1.0 / len(ids)
+            for item_id in ids:
+                scores[item_id] = scores.get(item_id, 0.0) + weight
+
+        # Ties go to the more recent item
+        best = sorted(scores, key=lambda item_id: (-scores[item_id], -item_id))[:k]
+        return [self.items[item_id - self.base] for item_id in best]
+
 class Chronicler:
     """
-    Conversational Memory System (unchanged from original)
+    Conversational Memory System
+
+    current_summary is a rolling summary that is only updated once the
+    unsummarized text exceeds summary_token_budget; until then new items reach
+    the Advisor verbatim. Rare folds keep the summary, and with it the cached
+    prompt prefix, unchanged across most questions. A fold runs in the
+    background and is cancelled when a question starts, so answers never wait
+    on it; cancelled items simply stay unsummarized for the next fold.
     """
 
     def __init__(self, config: CognitiveConfig):
         self.config = config
         self.context_store = deque(maxlen=config.context_max_length)
+        self.transcript_index = TranscriptIndex(config.transcript_index_max_items)
         self.current_summary = ""
         self.entities = {}
         self.last_summarization = time.time()
         self.pending_text = ""
+        self.pending_stream = None
+        self.pending_speaker = None
+        # Items not yet folded into current_summary, oldest first
+        self.unsummarized: List[str] = []
+        # async (summary, new_text) -> Optional[str]; set by the engine
+        self.summarizer = None
+        self._summary_task: Optional[asyncio.Task] = None
+        # Advisor calls in flight; no fold starts while one is waiting on the model
+        self._summary_holds = 0
+        self.changed = False
 
         logger.info(f"Chronicler initialized with max_length={config.context_max_length}")
 
-    def add_transcription(self, text: str, timestamp: float = None):
+    def add_transcription(self, text: str, timestamp: float = None, stream_id: str = "remote",
+                          speaker: Optional[str] = None):
         """Add new transcription to context store"""
         if timestamp is None:
             timestamp = time.time()
 
-        self.pending_text += f" {text}".strip()
+        # Never merge words from different streams or speakers into one context item
+        if self.pending_stream not in (None, stream_id) or self.pending_speaker != speaker:
+            self._trigger_summarization()
+        self.pending_stream = stream_id
+        self.pending_speaker = speaker
+
+        self.pending_text = f"{self.pending_text} {text}".strip()
 
         # Check if we have a complete sentence or timer expired
         has_sentence = any(punct in text for punct in '.!?')
@@ -250,55 +832,202 @@ class Chronicler:
         if not self.pending_text.strip():
             return
 
-        self.context_store.append({
+        item = {
             'timestamp': time.time(),
+            'stream': self.pending_stream,
+            'speaker': self.pending_speaker,
             'text': self.pending_text.strip()
-        })
+        }
+        self.context_store.append(item)
+        self.transcript_index.append(item)
+        self.unsummarized.append(item['text'])
+        self.changed = True
 
         self.pending_text = ""
         self.last_summarization = time.time()
 
         logger.info(f"Context updated: {len(self.context_store)} items")
 
-    def get_context_dict(self) -> Dict[str, Any]:
-        """Get current context for Advisor prompts"""
+        if self._over_budget():
+            self.request_summary()
+
+    def _over_budget(self) -> bool:
+        return sum(len(text) for text in self.unsummarized) > self.config.summary_token_budget
+
+    def request_summary(self):
+        """Fold unsummarized items into the summary in the background, if any are waiting"""
+        if not self.summarizer or not self.unsummarized or self._summary_holds:
+            return
+        if self._summary_task and not self._summary_task.done():
+            return
+        self._summary_task = asyncio.create_task(self._fold_summary())
+
+    def pause_summarization(self):
+        """Cancel an in-flight fold so it does not compete with a question for the model"""
+        if self._summary_task and not self._summary_task.done():
+            self._summary_task.cancel()
+        self._summary_task = None
+
+    def hold_summarization(self):
+        self._summary_holds += 1
+        self.pause_summarization()
+
+    def release_summarization(self):
+        """End of an Advisor call: resume a fold the call held back or cancelled"""
+        self._summary_holds = max(0, self._summary_holds - 1)
+        if self._over_budget():
+            self.request_summary()
+
+    async def _fold_summary(self):
+        batch = len(self.unsummarized)
+        try:
+            summary = await self.summarizer(self.current_summary, "\n".join(self.unsummarized[:batch]))
+        except asyncio.CancelledError:
+            return
+        if summary:
+            self.current_summary = summary
+            del self.unsummarized[:batch]
+            self.changed = True
+            logger.info(f"Summary updated ({batch} items folded)")
+
+    def get_context_dict(self, query: Optional[str] = None) -> Dict[str, Any]:
+        """Get current context for Advisor prompts, plus past items relevant to query"""
+        relevant = []
+        if query:
+            # The question itself is usually indexed already; don't hand it back
+            k = self.config.context_retrieval_k
+            relevant = [item['text'] for item in self.transcript_index.search(query, k + 1)
+                        if query.strip() not in item['text']][:k]
+        # Not summarized yet, but the Advisor should still see it. Relevant items
+        # may also be in here; only the prompt builder knows how much of it fits
+        recent = " ".join(self.unsummarized)
         return {
             "summary": self.current_summary,
-            "entities": self.entities
+            "recent": recent,
+            "entities": self.entities,
+            "relevant": relevant
         }
 
     def debug_print_context(self):
         """Debug method: print current context state"""
         print(f"\n=== CHRONICLER DEBUG ({time.strftime('%H:%M:%S')}) ===")
-        print(f"Context items: {len(self.context_store)}")
+        print(f"Context items: {len(self.context_store)} (indexed: {len(self.transcript_index)}, "
+              f"unsummarized: {len(self.unsummarized)})")
         print(f"Current summary: {self.current_summary}")
         print(f"Entities: {list(self.entities.keys())}")
         print("=" * 50)
 
 class Advisor:
     """
-    Real-time Assistance Engine (unchanged from original)
+    Real-time Assistance Engine
+
+    The instructions are sent as a fixed system prompt and the per-question
+    prompt keeps slowly-changing context ahead of the question, so Ollama's
+    prompt cache only has to prefill the tail. Summary folds send the same
+    system prompt, so on a single-slot server (OLLAMA_NUM_PARALLEL=1) a fold
+    only replaces the part of the cache after it. One HTTP session is kept
+    open and the model is kept loaded with keep_alive.
     """
 
+    SYSTEM_PROMPT = """You are a real-time AI assistant providing brief, bullet-pointed answers for questions during live conversations.
+
+Answer in this format:
+• Key point 1
+• Key point 2
+• Key point 3 (if relevant)
+
+Keep each bullet under 10 words. Focus on essential information only."""
+
     def __init__(self, config: CognitiveConfig, chronicler: Chronicler):
         self.config = config
         self.chronicler = chronicler
         self.question_regex = re.compile('|'.join(config.question_patterns), re.IGNORECASE)
         self.last_response_time = 0
         self.ollama_url = f"http://{config.ollama_host}:{config.ollama_port}/api/generate"
+        self.session: Optional[aiohttp.ClientSession] = None
 
         logger.info(f"Advisor initialized with model={config.advisor_model}")
 
-    def is_question(self, text: str) -> bool:
-        """Fast regex check if text contains a question"""
+    def is_question(self, text: str, hint: Optional[bool] = None) -> bool:
+        """Fast regex check if text contains a question; a flag from the tool wins"""
+        if hint is not None:
+            return hint
         return bool(self.question_regex.search(text.strip()))
 
+    def _get_session(self) -> aiohttp.ClientSession:
+        # Reused across calls so each question skips connection setup
+        if self.session is None or self.session.closed:
+            self.session = aiohttp.ClientSession()
+        return self.session
+
+    async def warm_up(self):
+        """Load the Advisor model and prefill the system prompt before the first question"""
+        # An empty prompt only loads the model; a real one renders the template,
+        # so the system prompt is evaluated and cached. One token is enough
+        payload = {
+            "model": self.config.advisor_model,
+            "system": self.SYSTEM_PROMPT,
+            "prompt": "Ready?",
+            "stream": False,
+            "keep_alive": self.config.advisor_keep_alive,
+            "options": {"num_predict": 1}
+        }
+        try:
+            # Model loading is slow; this runs at startup, not on a question
+            timeout = aiohttp.ClientTimeout(total=60)
+            async with self._get_session().post(self.ollama_url, json=payload, timeout=timeout) as response:
+                if response.status == 200:
+                    logger.info(f"Advisor model {self.config.advisor_model} loaded")
+                else:
+                    logger.warning(f"Advisor warm-up failed: {response.status}")
+        except Exception as e:
+            logger.warning(f"Advisor warm-up failed: {e}")
+
+    async def summarize(self, summary: str, new_text: str) -> Optional[str]:
+        """Fold new transcript text into the rolling summary (Chronicler.summarizer)"""
+        # About a third of the prompt's context budget (~6 characters per word),
+        # leaving room for retrieved items and recent text next to it
+        words = max(10, self.config.max_context_tokens // 3 // 6)
+        payload = {
+            "model": self.config.advisor_model,
+            "system": self.SYSTEM_PROMPT,
+            "prompt": f"""Current meeting summary: {summary or "none"}
+
+New transcript:
+{new_text}
+
+Rewrite the meeting summary to include the new transcript. Keep names, numbers, decisions and open questions. Reply with the summary only, under {words} words.""",
+            "stream": False,
+            "keep_alive": self.config.advisor_keep_alive,
+            "options": {"temperature": 0.2, "num_predict": words * 2}
+        }
+        try:
+            timeout = aiohttp.ClientTimeout(total=self.config.summary_timeout)
+            async with self._get_session().post(self.ollama_url, json=payload, timeout=timeout) as response:
+                if response.status != 200:
+                    logger.warning(f"Summary request failed: {response.status}")
+                    return None
+                result = await response.json()
+                return result.get('response', '').strip() or None
+        except asyncio.TimeoutError:
+            logger.warning(f"Summary timeout ({self.config.summary_timeout}s)")
+            return None
+        except Exception as e:
+            logger.warning(f"Summary error: {e}")
+            return None
+
+    async def close(self):
+        if self.session and not self.session.closed:
+            await self.session.close()
+
     async def _call_ollama(self, prompt: str) -> Optional[str]:
-        """Make async call to Ollama API with timeout"""
+        """Stream from the Ollama API; on timeout keep the bullets completed so far"""
         payload = {
             "model": self.config.advisor_model,
+            "system": self.SYSTEM_PROMPT,
             "prompt": prompt,
-            "stream": False,
+            "stream": True,
+            "keep_alive": self.config.advisor_keep_alive,
             "options": {
                 "temperature": 0.3,
                 "top_k": 20,
@@ -307,63 +1036,110 @@ class Advisor:
             }
         }
 
+        pieces: List[str] = []
         try:
             timeout = aiohttp.ClientTimeout(total=self.config.advisor_timeout)
-            async with aiohttp.ClientSession(timeout=timeout) as session:
-                async with session.post(self.ollama_url, json=payload) as response:
-                    if response.status == 200:
-                        result = await response.json()
-                        return result.get('response', '').strip()
-                    else:
-                        logger.error(f"Ollama API error: {response.status}")
-                        return None
+            async with self._get_session().post(self.ollama_url, json=payload, timeout=timeout) as response:
+                if response.status != 200:
+                    logger.error(f"Ollama API error: {response.status}")
+                    return None
+                async for line in response.content:
+                    if not line.strip():
+                        continue
+                    chunk = json.loads(line)
+                    pieces.append(chunk.get('response', ''))
+                    if chunk.get('done'):
+                        break
+            return ''.join(pieces).strip()
         except asyncio.TimeoutError:
+            # Only whole lines are kept; a half-written bullet is worse than none
+            partial = ''.join(pieces)
+            partial = partial[:partial.rfind('\n') + 1].strip()
+            if partial:
+                logger.warning(f"Ollama timeout ({self.config.advisor_timeout}s); using partial answer")
+                return partial
             logger.warning(f"Ollama timeout ({self.config.advisor_timeout}s)")
             return None
         except Exception as e:
             logger.error(f"Ollama error: {e}")
             return None
 
+    @staticmethod
+    def _tail(text: str, budget: int) -> str:
+        """The newest budget characters of text; the newest text matters most"""
+        if len(text) <= budget:
+            return text
+        return "..." + text[len(text) - budget:] if budget > 0 else ""
+
     def _build_advisor_prompt(self, question: str, context: Dict[str, Any]) -> str:
-        """Build prompt for Advisor with context"""
+        """Build the per-question prompt; instructions live in SYSTEM_PROMPT"""
+        total = self.config.max_context_tokens
+        reserved = int(total * self.config.context_retrieval_share)
+        retrieved = context.get('relevant', [])
+
+        # Retrieved items keep their share even against a long summary
         summary = context.get('summary', '')
-        if len(summary) > self.config.max_context_tokens:
-            summary = summary[:self.config.max_context_tokens] + "..."
+        limit = total - reserved if retrieved else total
+        if len(summary) > limit:
+            summary = summary[:limit] + "..."
 
         entities = context.get('entities', {})
         entity_str = ", ".join(entities.keys()) if entities else "none"
 
-        prompt = f"""You are a real-time AI assistant providing brief, bullet-pointed answers for questions during live conversations.
-
+        # Recent text gets what the summary and the retrieval share leave, and
+        # takes back whatever part of the share the retrieved items do not use
+        budget = max(0, total - len(summary))
+        full_recent = context.get('recent', '')
+        recent = self._tail(full_recent, budget - min(reserved, budget) if retrieved else budget)
+
+        relevant = []
+        room = budget - len(recent)
+        for text in retrieved:
+            if text in recent:
+                continue
+            if len(text) > room:
+                # A long item is still worth its opening words
+                if room < 40:
+                    break
+                text = text[:room - 3] + "..."
+            relevant.append(f"- {text}")
+            room -= len(text)
+        if room > 0:
+            recent = self._tail(full_recent, len(recent) + room)
+        relevant_str = "\n".join(relevant) if relevant else "none"
+
+        # Ordered by how often each part changes, so the cached prefix runs as far
+        # as possible: entities rarely, the summary on a budget fold, retrieved
+        # items per question, recent text per utterance, the question every call
+        prompt = f"""Current Entities: {entity_str}
 Context Summary: {summary}
-Current Entities: {entity_str}
+Earlier in this meeting:
+{relevant_str}
+Latest: {recent or "none"}
 
-Question: {question}
-
-Provide a concise response in this format:
-• Key point 1
-• Key point 2
-• Key point 3 (if relevant)
-
-Keep each bullet under 10 words. Focus on essential information only."""
+Question: {question}"""
 
         return prompt
 
-    async def process_text(self, text: str) -> Optional[str]:
-        """Process incoming text and generate advice if needed"""
-        if not self.is_question(text):
+    async def process_text(self, text: str, classified: bool = False) -> Optional[str]:
+        """Process incoming text and generate advice if needed; classified skips the question check"""
+        if not classified and not self.is_question(text):
             return None
 
         start_time = time.time()
+        self.chronicler.hold_summarization()
 
         # Get context from Chronicler
-        context = self.chronicler.get_context_dict()
+        context = self.chronicler.get_context_dict(text)
 
         # Build prompt with context
         prompt = self._build_advisor_prompt(text, context)
 
-        # Call Ollama
-        response = await self._call_ollama(prompt)
+        # Call Ollama; the summary catches up once the model is free again
+        try:
+            response = await self._call_ollama(prompt)
+        finally:
+            self.chronicler.release_summarization()
 
         response_time = time.time() - start_time
         self.last_response_time = response_time
@@ -375,90 +1151,1038 @@ Keep each bullet under 10 words. Focus on essential information only."""
             logger.warning(f"No response from Advisor for: {text}")
             return None
 
+class PcmRingBuffer:
+    """
+    Fixed-capacity s16le ring between the ffmpeg reader and the whisper writer.
+    Capture never waits on decoding: when whisper falls behind, the oldest audio
+    is overwritten and counted in overflow_bytes instead of stalling ffmpeg.
+    Single producer / single consumer on one event loop, so no locking is needed.
+    """
+
+    def __init__(self, capacity_bytes: int, frame_bytes: int = 2):
+        self.frame_bytes = frame_bytes
+        self.capacity = capacity_bytes - capacity_bytes % frame_bytes
+        self._buf = bytearray(self.capacity)
+        self._view = memoryview(self._buf)
+        # Absolute stream positions; always multiples of frame_bytes
+        self._read_pos = 0
+        self._write_pos = 0
+        self._data_ready = asyncio.Event()
+        self.closed = False
+
+        self.overflow_bytes = 0
+        self.overflow_events = 0
+
+    def __len__(self) -> int:
+        return self._write_pos - self._read_pos
+
+    def write(self, data) -> int:
+        """Append frame-aligned PCM, dropping the oldest audio on overflow. Returns bytes dropped."""
+        view = memoryview(data)
+        dropped = 0
+
+        if len(view) > self.capacity:
+            dropped += len(view) - self.capacity
+            view = view[-self.capacity:]
+
+        free = self.capacity - len(self)
+        if len(view) > free:
+            overrun = len(view) - free
+            self._read_pos += overrun
+            dropped += overrun
+
+        if dropped:
+            self.overflow_bytes += dropped
+            self.overflow_events += 1
+
+        offset = self._write_pos % self.capacity
+        first = min(len(view), self.capacity - offset)
+        self._view[offset:offset + first] = view[:first]
+        if first < len(view):
+            self._view[:len(view) - first] = view[first:]
+        self._write_pos += len(view)
+
+        if len(view):
+            self._data_ready.set()
+        return dropped
+
+    async def read(self, max_bytes: int) -> Optional[memoryview]:
+        """
+        Wait for data and return a contiguous, frame-aligned view of up to max_bytes.
+        The view is only valid until the next write; the caller must hand it off
+        (e.g. StreamWriter.write copies) before yielding to the event loop.
+        Returns None once the ring is closed and drained.
+        """
+        while not len(self):
+            if self.closed:
+                return None
+            self._data_ready.clear()
+            await self._data_ready.wait()
+
+        offset = self._read_pos % self.capacity
+        size = min(len(self), max_bytes, self.capacity - offset)
+        size -= size % self.frame_bytes
+        self._read_pos += size
+        return self._view[offset:offset + size]
+
+    def skip(self, max_bytes: int) -> int:
+        """Discard up to max_bytes of the oldest buffered audio; returns bytes skipped"""
+        size = min(len(self), max(0, max_bytes))
+        size -= size % self.frame_bytes
+        self._read_pos += size
+        return size
+
+    def reset(self):
+        """Discard buffered audio for a fresh pipeline; overflow totals are kept"""
+        self._read_pos = 0
+        self._write_pos = 0
+        self._data_ready.clear()
+        self.closed = False
+
+    def close(self):
+        """Wake the consumer so it can exit once drained"""
+        self.closed = True
+        self._data_ready.set()
+
+class TranscriptStabilizer:
+    """
+    LocalAgreement-style commit policy for sliding-window transcripts.
+    whisper-stream-stdin re-transcribes overlapping audio, so each line repeats
+    and revises the tail of the previous one. Words are committed only once the
+    last N hypotheses agree on them; anything after that is tentative. Words that
+    were already committed are trimmed from the front of new hypotheses so they
+    are never emitted twice.
+
+    Agreement advances a few words at a time, so committed words are held back
+    until they form an utterance: up to a sentence boundary, or everything once
+    no tentative tail is left. Consumers only ever see whole utterances.
+    """
+
+    SENTENCE_END = re.compile(r"[.?!…][\"')\]]*$")
+
+    def __init__(self, agreement_steps: int = 2, tail_words: int = 32, max_utterance_words: int = 48):
+        self.agreement_steps = max(1, agreement_steps)
+        self.history = deque(maxlen=self.agreement_steps)
+        self.committed_tail = deque(maxlen=tail_words)
+        self.max_utterance_words = max_utterance_words
+        self.pending: List[str] = []
+        self.tentative = ""
+
+    @staticmethod
+    def _norm(word: str) -> str:
+        return re.sub(r"[^\w']", "", word.lower())
+
+    def _trim_committed(self, words: List[str]) -> List[str]:
+        """Drop the longest prefix of words that repeats the committed tail"""
+        tail = [self._norm(w) for w in self.committed_tail]
+        head = [self._norm(w) for w in words]
+        for k in range(min(len(tail), len(head)), 0, -1):
+            if tail[-k:] == head[:k]:
+                return words[k:]
+        return words
+
+    def _commit(self, words: List[str]) -> str:
+        self.committed_tail.extend(words)
+        return " ".join(words)
+
+    def _utterance(self, committed: List[str], tail: List[str]) -> Tuple[str, str]:
+        """Queue newly committed words; release them up to the last sentence boundary"""
+        self.pending.extend(committed)
+        if not tail or len(self.pending) >= self.max_utterance_words:
+            cut = len(self.pending)
+        else:
+            cut = 0
+            for i, word in enumerate(self.pending):
+                if self.SENTENCE_END.search(word):
+                    cut = i + 1
+        utterance = " ".join(self.pending[:cut])
+        del self.pending[:cut]
+        self.tentative = " ".join(self.pending + tail)
+        return utterance, self.tentative
+
+    def update(self, text: str) -> Tuple[str, str]:
+        """Feed one hypothesis line; returns (completed utterance, tentative text)"""
+        words = self._trim_committed(text.split())
+
+        if self.agreement_steps == 1:
+            self.committed_tail.extend(words)
+            return self._utterance(words, [])
+
+        committed = []
+        if self.history:
+            previous = self.history[-1]
+            if previous and words and self._norm(previous[0]) != self._norm(words[0]):
+                # Nothing in common with the last hypothesis: the window moved on to
+                # new audio, so the superseded hypothesis is the best we will get
+                committed = previous
+                self.committed_tail.extend(committed)
+                self.history.clear()
+                words = self._trim_committed(words)
+
+        self.history.append(words)
+
+        if len(self.history) == self.agreement_steps:
+            normed = [[self._norm(w) for w in h] for h in self.history]
+            agreed = 0
+            for column in zip(*normed):
+                if any(w != column[0] for w in column):
+                    break
+                agreed += 1
+            if agreed:
+                committed = committed + words[:agreed]
+                self.committed_tail.extend(words[:agreed])
+                self.history = deque((h[agreed:] for h in self.history), maxlen=self.agreement_steps)
+                words = words[agreed:]
+
+        return self._utterance(committed, words)
+
+    def flush(self) -> str:
+        """Commit whatever is still pending or tentative (end of stream or speech)"""
+        words = list(self.history[-1]) if self.history else []
+        self.history.clear()
+        self.committed_tail.extend(words)
+        utterance = " ".join(self.pending + words)
+        self.pending = []
+        self.tentative = ""
+        return utterance
+
+class HallucinationGuard:
+    """
+    Drops decoder loops and silence hallucinations before they are committed:
+    the stock phrases Whisper produces on noise, runs of a repeated n-gram,
+    text that compresses too well (a loop that the n-gram check tolerates),
+    and segments the tool itself scores as probably not speech. People do say
+    "thank you", so a stock phrase alone is not enough: it also needs a low
+    score, or, when the tool reports none, to arrive alone after a quiet spell.
+    """
+
+    def __init__(self, config: CognitiveConfig):
+        self.config = config
+        self.phrases = {self._norm(phrase) for phrase in config.hallucination_phrases}
+        self.last_kept = 0.0
+
+    @staticmethod
+    def _norm(text: str) -> str:
+        return re.sub(r"[^\w\[\]()' ]", "", text.lower()).strip()
+
+    def _repeated_ngram(self, words: List[str]) -> bool:
+        """A run of one n-gram repeated back to back; short stutters ("I, I, I") pass"""
+        limit = self.config.max_ngram_repeats
+        for n in range(1, 9):
+            for start in range(len(words) - n * limit + 1):
+                gram = words[start:start + n]
+                repeats = 1
+                while words[start + repeats * n:start + (repeats + 1) * n] == gram:
+                    repeats += 1
+                if repeats >= limit and repeats * n >= 8:
+                    return True
+        return False
+
+    def _doubtful(self, segment: 'TranscriptSegment', now: float) -> bool:
+        """Low confidence from the tool, or (unscored) nothing else heard for a while"""
+        c = self.config
+        if segment.no_speech_prob is None and segment.avg_logprob is None:
+            return now - self.last_kept >= c.hallucination_gap_seconds
+        return ((segment.no_speech_prob is not None and segment.no_speech_prob > c.no_speech_threshold)
+                or (segment.avg_logprob is not None and segment.avg_logprob < c.logprob_threshold))
+
+    def check(self, segment: 'TranscriptSegment') -> Optional[str]:
+        """Why the segment should be dropped, or None to keep it"""
+        reason = self._check(segment)
+        if reason is None:
+            self.last_kept = time.monotonic()
+        return reason
+
+    def _check(self, segment: 'TranscriptSegment') -> Optional[str]:
+        c = self.config
+        # Whisper's own rule: a likely-silent window is only skipped when the
+        # decode was also unsure; a confident decode over "silence" is speech
+        if (segment.no_speech_prob is not None and segment.no_speech_prob > c.no_speech_threshold
+                and segment.avg_logprob is not None and segment.avg_logprob < c.logprob_threshold):
+            return "no speech"
+
+        text = segment.text
+        if self._norm(text) in self.phrases and self._doubtful(segment, time.monotonic()):
+            return "stock phrase"
+
+        words = self._norm(text).split()
+        if self._repeated_ngram(words):
+            return "repetition"
+
+        # Short text compresses badly whatever it says; only judge real sentences
+        encoded = text.encode("utf-8")
+        if len(encoded) >= 60 and len(encoded) / len(zlib.compress(encoded)) > c.compression_ratio_threshold:
+            return "compression ratio"
+        return None
+
+class LanguageTracker:
+    """
+    Per-stream language lock with hysteresis. Unlocked, the tool runs with
+    -l auto and reports a language per segment; once lock_segments
+    consecutive confident segments agree, the stream is pinned to it.
+    A pinned stream is released after release_segments consecutive segments
+    below release_logprob, which is what decoding in the wrong language
+    looks like, or when a confident detection names another language.
+    """
+
+    def __init__(self, config: CognitiveConfig):
+        self.candidates = set(config.whisper_languages)
+        self.lock_prob = config.language_lock_prob
+        self.lock_segments = max(1, config.language_lock_segments)
+        self.release_logprob = config.language_release_logprob
+        self.release_segments = max(1, config.language_release_segments)
+        self.locked: Optional[str] = None
+        self._candidate: Optional[str] = None
+        self._streak = 0
+
+    def sync(self, language: str):
+        """Align with the language the running process actually uses"""
+        self.locked = None if language == "auto" else language
+        self._candidate = None
+        self._streak = 0
+
+    def observe(self, segment: 'TranscriptSegment') -> Optional[str]:
+        """Returns the language to switch to ("auto" to release), or None to stay"""
+        confident = (segment.lang and segment.lang_prob is not None
+                     and segment.lang_prob >= self.lock_prob)
+
+        if self.locked is None:
+            if not confident or (self.candidates and segment.lang not in self.candidates):
+                self._streak = 0
+                return None
+            if segment.lang == self._candidate:
+                self._streak += 1
+            else:
+                self._candidate, self._streak = segment.lang, 1
+            return self._candidate if self._streak >= self.lock_segments else None
+
+        if confident and segment.lang != self.locked:
+            return "auto"
+        if segment.avg_logprob is not None and segment.avg_logprob < self.release_logprob:
+            self._streak += 1
+        else:
+            self._streak = 0
+        return "auto" if self._streak >= self.release_segments else None
+
+@dataclass
+class TranscriptSegment:
+    """
+    One result from whisper-stream-stdin. In ndjson mode every stdout line is a
+    JSON object with these fields; plain text lines only carry text, and
+    is_final is None so the stabilizer decides what is committed.
+    """
+    text: str
+    segment_id: Optional[int] = None
+    t0: Optional[float] = None
+    t1: Optional[float] = None
+    is_final: Optional[bool] = None
+    avg_logprob: Optional[float] = None
+    encode_ms: Optional[float] = None
+    decode_ms: Optional[float] = None
+    speaker: Optional[str] = None
+    # Set when the tool classified the segment itself; None falls back to the regex
+    is_question: Optional[bool] = None
+    # Detected language and its probability, reported while running with -l auto
+    lang: Optional[str] = None
+    lang_prob: Optional[float] = None
+    no_speech_prob: Optional[float] = None
+
+    @staticmethod
+    def _field(record: Dict[str, Any], key: str, types: tuple):
+        """An optional field of the given types; anything else makes the record invalid"""
+        value = record.get(key)
+        # bool is an int subclass, but true is not a timestamp
+        if value is not None and (not isinstance(value, types)
+                                  or (isinstance(value, bool) and bool not in types)):
+            raise ValueError(f"{key}={value!r}")
+        return value
+
+    @classmethod
+    def from_record(cls, record: Dict[str, Any]) -> 'TranscriptSegment':
+        """Build a segment from one decoded NDJSON record; raises ValueError on a mistyped field"""
+        number = (int, float)
+        text = cls._field(record, 'text', (str,))
+        speaker = record.get('speaker')
+        return cls(
+            text=(text or '').strip(),
+            segment_id=cls._field(record, 'id', (int,)),
+            t0=cls._field(record, 't0', number),
+            t1=cls._field(record, 't1', number),
+            is_final=cls._field(record, 'is_final', (bool,)),
+            avg_logprob=cls._field(record, 'avg_logprob', number),
+            encode_ms=cls._field(record, 'encode_ms', number),
+            decode_ms=cls._field(record, 'decode_ms', number),
+            speaker=None if speaker is None else str(speaker),
+            is_question=cls._field(record, 'is_question', (bool,)),
+            lang=cls._field(record, 'lang', (str,)),
+            lang_prob=cls._field(record, 'lang_prob', number),
+            no_speech_prob=cls._field(record, 'no_speech_prob', number),
+        )
+
+class SessionRecorder:
+    """
+    Recording of one stream for later review. The capture ffmpeg writes the
+    unfiltered audio itself as fixed-length FLAC chunks, so the hot path pays
+    nothing; this side only appends index records. Chunk N starts at
+    N * chunk_seconds of its capture run, so any segment maps to one chunk file
+    and an offset inside it without decoding anything else.
+    """
+
+    def __init__(self, directory: str, stream_id: str, chunk_seconds: int = 10):
+        os.makedirs(directory, exist_ok=True)
+        self.directory = directory
+        self.stream_id = stream_id
+        self.chunk_seconds = chunk_seconds
+        self.attach_chunk = 0
+        self.attached_at: Optional[float] = None
+        # Line-buffered so the index survives a crash up to the last segment
+        self.index = open(os.path.join(directory, f"{stream_id}.index.ndjson"), "a",
+                          encoding="utf-8", buffering=1)
+
+    def chunk_path(self, chunk: int) -> str:
+        return os.path.join(self.directory, f"{self.stream_id}-{chunk:06d}.flac")
+
+    def _next_chunk(self) -> int:
+        """First unused chunk number, so a reattached capture never overwrites audio"""
+        prefix = f"{self.stream_id}-"
+        numbers = [int(name[len(prefix):-5]) for name in os.listdir(self.directory)
+                   if name.startswith(prefix) and name.endswith(".flac") and name[len(prefix):-5].isdigit()]
+        return max(numbers) + 1 if numbers else 0
+
+    def output_args(self, config: CognitiveConfig) -> List[str]:
+        """Second ffmpeg output for a new capture run; the attach point follows with the first audio"""
+        self.attach_chunk = self._next_chunk()
+        # Spawning ffmpeg and opening the device take a variable while; segments
+        # are not indexed until mark_attached() knows when audio really started
+        self.attached_at = None
+        return [
+            "-ac", str(config.channels),
+            "-ar", str(config.sample_rate),
+            "-c:a", "flac",
+            "-f", "segment",
+            "-segment_time", str(self.chunk_seconds),
+            "-segment_start_number", str(self.attach_chunk),
+            "-reset_timestamps", "1",
+            os.path.join(self.directory, f"{self.stream_id}-%06d.flac"),
+        ]
+
+    def mark_attached(self, buffered_seconds: float = 0.0):
+        """First PCM of a capture run arrived, carrying buffered_seconds of audio"""
+        self.attached_at = time.time() - buffered_seconds
+        self._write({"type": "capture", "chunk": self.attach_chunk, "wall": round(self.attached_at, 3)})
+
+    def add_segment(self, text: str, speaker: Optional[str] = None):
+        """Index a committed segment at the capture position it was committed at"""
+        if self.attached_at is None:
+            return
+        now = time.time()
+        elapsed = max(0.0, now - self.attached_at)
+        chunk = self.attach_chunk + int(elapsed // self.chunk_seconds)
+        self._write({
+            "type": "segment",
+            "wall": now,
+            "chunk": chunk,
+            "offset": round(elapsed % self.chunk_seconds, 3),
+            "text": text,
+            "speaker": speaker,
+        })
+
+    def add_gap(self, seconds: float):
+        """Audio that was recorded but skipped by the transcriber (the audio itself is kept)"""
+        self._write({"type": "gap", "wall": time.time(), "seconds": round(seconds, 3)})
+
+    def _write(self, record: Dict[str, Any]):
+        try:
+            self.index.write(json.dumps(record, ensure_ascii=False) + "\n")
+        except (OSError, ValueError) as e:
+            logger.warning(f"Recording index write failed [{self.stream_id}]: {e}")
+
+    def close(self):
+        self.index.close()
+
 class AudioPipeline:
     """
     NEW: Python-native audio pipeline using subprocess management
     This replaces the problematic C++ WebSocket server entirely
     """
 
-    def __init__(self, config: CognitiveConfig):
+    def __init__(self, config: CognitiveConfig, stream_id: str = "remote", audio_device: Optional[str] = None,
+                 metrics: Optional[PipelineMetrics] = None, recorder: Optional[SessionRecorder] = None):
         self.config = config
+        self.metrics = metrics or PipelineMetrics()
+        self.recorder = recorder
+        self.stream_id = stream_id
+        self.audio_device = audio_device or config.audio_device
         self.ffmpeg_proc = None
         self.whisper_proc = None
         self.running = False
-
-        logger.info("Audio Pipeline initialized (Python-native streaming)")
-
-    async def start_pipeline(self, transcript_callback):
-        """Start the ffmpeg -> whisper-stream-stdin pipeline"""
+        self.bytes_per_second = config.sample_rate * config.channels * 2
+        self.ring = PcmRingBuffer(int(config.audio_buffer_seconds * self.bytes_per_second),
+                                  frame_bytes=config.channels * 2)
+        self._relay_tasks = []
+        # Bound once so per-chunk observations build no label dicts or keys
+        self._observe_read_wait = self.metrics.bind("pipe_read_wait", stream=stream_id)
+        self._observe_write_wait = self.metrics.bind("whisper_write_wait", stream=stream_id)
+        self._observe_ring_depth = self.metrics.bind("ring_depth", stream=stream_id)
+        self.stabilizer = TranscriptStabilizer(config.transcript_agreement_steps)
+        self.guard = HallucinationGuard(config) if config.hallucination_guard else None
+        self.dropped_segments = 0
+        self.last_segment: Optional[TranscriptSegment] = None
+        self.capture_restarts = 0
+        # Speech tail after the VAD gate closes (armed by every captured chunk)
+        self.tail_bytes = int(config.vad_tail_seconds * self.bytes_per_second) if config.vad_enabled else 0
+        self._tail_left = 0
+        self._tail_done_at = 0.0
+        self._last_audio_at = 0.0
+        self._last_output_at = 0.0
+
+        # Model hot-swap: ladder from the configured model down to the smallest fallback
+        self.model_ladder = [config.whisper_model] + list(config.whisper_fallback_models)
+        self.active_model = config.whisper_model
+        self.active_language = config.whisper_language
+        self.language_tracker = (LanguageTracker(config) if config.whisper_language == "auto"
+                                 and config.whisper_output_format == "ndjson" else None)
+        self.measured_rtf: Optional[float] = None
+        self.bytes_to_whisper = 0
+        self.max_backlog_bytes = int(config.max_backlog_seconds * self.bytes_per_second)
+        self.skip_to_bytes = int(config.backlog_skip_to_seconds * self.bytes_per_second)
+        self.skipped_bytes = 0
+        self.gaps = 0
+        # Engine hook: gap_callback(stream_id, skipped_ms)
+        self.gap_callback = None
+        self._swapping = False
+        self._retiring: Set[asyncio.subprocess.Process] = set()
+
+        logger.info(f"Audio Pipeline [{stream_id}] initialized (Python-native streaming)")
+
+    def _capture_input_args(self) -> List[str]:
+        """ffmpeg input options for the configured capture backend"""
+        c = self.config
+        if c.capture_backend == "dshow":
+            args = ["-f", "dshow"]
+            if c.capture_buffer_ms:
+                args += ["-audio_buffer_size", str(c.capture_buffer_ms)]
+            if c.capture_device_format:
+                args += [
+                    "-sample_rate", str(c.sample_rate),
+                    "-channels", str(c.channels),
+                    "-sample_size", "16",
+                ]
+            return args + ["-i", f"audio={self.audio_device}"]
+        if c.capture_backend == "avfoundation":
+            # Audio-only CoreAudio capture: ":<audio device>"
+            return ["-f", "avfoundation", "-i", f":{self.audio_device}"]
+        args = ["-f", c.capture_backend]
+        if c.capture_backend == "pulse" and c.capture_buffer_ms:
+            args += ["-fragment_size", str(c.capture_buffer_ms * c.sample_rate * c.channels * 2 // 1000)]
+        return args + ["-i", self.audio_device]
+
+    def _build_ffmpeg_cmd(self) -> List[str]:
+        """ffmpeg command that captures the device and writes raw PCM to stdout"""
+        ffmpeg_cmd = [
+            "ffmpeg",
+            "-hide_banner",
+            "-nostats",
+            "-fflags", "nobuffer",
+        ]
+        ffmpeg_cmd += self._capture_input_args()
+        if self.config.vad_enabled:
+            ffmpeg_cmd += ["-af", self._vad_filter()]
+        ffmpeg_cmd += [
+            # Still enforced on output; a no-op when the device already matches
+            "-ac", str(self.config.channels),
+            "-ar", str(self.config.sample_rate),
+            "-acodec", "pcm_s16le",
+            # Without this the 32 KB output buffer holds ~1s of 16 kHz mono audio
+            "-flush_packets", "1",
+            "-f", "s16le",
+            "-"  # Output to stdout
+        ]
+        # Output options apply per output, so the recording skips the VAD filter
+        if self.recorder:
+            ffmpeg_cmd += self.recorder.output_args(self.config)
+        return ffmpeg_cmd
+
+    def _build_whisper_cmd(self, model: Optional[str] = None, language: Optional[str] = None) -> List[str]:
+        """whisper-stream-stdin command line for a model and language (the active ones by default)"""
+        language = language or self.active_language
+        whisper_cmd = [
+            self.config.whisper_executable,
+            "-m", model or self.active_model,
+            "-t", str(self.config.whisper_threads),
+            "-l", language,
+        ]
+        whisper_cmd += self.config.whisper_language_args.get(language, [])
+        if self.config.whisper_output_format == "ndjson":
+            whisper_cmd += ["--output-format", "ndjson"]
+        else:
+            whisper_cmd += ["--no-timestamps"]
+        return whisper_cmd
+
+    async def start_pipeline(self, transcript_callback, tentative_callback=None):
+        """
+        Start the ffmpeg -> ring buffer -> whisper-stream-stdin pipeline.
+        Returns when whisper exits; capture failures are handled by reattaching a
+        new ffmpeg to the same whisper process so the model stays loaded.
+        """
         self.running = True
         self.transcript_callback = transcript_callback
+        self.tentative_callback = tentative_callback
 
         try:
-            # Create ffmpeg command to capture audio and output raw PCM
-            ffmpeg_cmd = [
-                "ffmpeg",
-                "-f", "dshow",
-                "-i", f"audio={self.config.audio_device}",
-                "-ac", str(self.config.channels),
-                "-ar", str(self.config.sample_rate),
-                "-acodec", "pcm_s16le",
-                "-f", "s16le",
-                "-"  # Output to stdout
+            logger.info(f"🎙️ Starting direct audio pipeline [{self.stream_id}]:")
+            # Start whisper process; its stdin is fed from the ring buffer
+            self.whisper_proc = await self._spawn_whisper(self.active_model)
+
+            # Decouple capture from inference: ffmpeg is drained continuously
+            # even while whisper_full is busy
+            self.ring.reset()
+            self.stabilizer = TranscriptStabilizer(self.config.transcript_agreement_steps)
+            self._relay_tasks += [
+                asyncio.create_task(self._run_capture()),
+                asyncio.create_task(self._whisper_writer()),
             ]
+            if len(self.model_ladder) > 1:
+                self._relay_tasks.append(asyncio.create_task(self._watch_realtime_factor()))
+            if self.tail_bytes:
+                self._relay_tasks.append(asyncio.create_task(self._feed_speech_tail()))
 
-            # Create whisper-stream-stdin command
-            whisper_cmd = [
-                self.config.whisper_executable,
-                "-m", self.config.whisper_model,
-                "-t", str(self.config.whisper_threads),
-                "-l", "en",
-                "--no-timestamps"
-            ]
+            # Process transcription output; a model swap hands over to the new process
+            while self.running and self.whisper_proc:
+                proc = self.whisper_proc
+                await self._process_whisper_output(proc)
+                if proc is self.whisper_proc:
+                    break
 
-            logger.info(f"🎙️ Starting direct audio pipeline:")
-            logger.info(f"  FFmpeg: {' '.join(ffmpeg_cmd)}")
-            logger.info(f"  Whisper: {' '.join(whisper_cmd)}")
+        except Exception as e:
+            logger.error(f"Pipeline error: {e}")
+        finally:
+            await self._teardown()
+
+    # Logged by whisper.cpp once the weights are in memory and the decode state
+    # is being allocated (or by the tool itself when it starts taking audio)
+    WHISPER_READY = re.compile(rb"whisper_init_state|\[Start speaking\]")
+
+    async def _spawn_whisper(self, model: str, stderr_activity: Optional[list] = None,
+                             language: Optional[str] = None):
+        """Start whisper-stream-stdin for a model with its stderr drained"""
+        whisper_cmd = self._build_whisper_cmd(model, language)
+        logger.info(f"  Whisper: {' '.join(whisper_cmd)}")
+        proc = await asyncio.create_subprocess_exec(
+            *whisper_cmd,
+            stdin=asyncio.subprocess.PIPE,
+            stdout=asyncio.subprocess.PIPE,
+            stderr=asyncio.subprocess.PIPE
+        )
+        self._place(proc, self.config.compute_cpus, self.config.lower_compute_priority)
+        self._relay_tasks.append(asyncio.create_task(
+            self._drain_stderr(proc.stderr, "whisper", stderr_activity)))
+        return proc
+
+    def _place(self, proc, cpus: List[int], below_normal: bool = False):
+        """Apply core placement to a child; failures only cost performance, so just log them"""
+        if not cpus and not below_normal:
+            return
+        try:
+            apply_process_placement(proc.pid, cpus, below_normal)
+        except Exception as e:
+            logger.warning(f"Could not set CPU placement for PID {proc.pid}: {e}")
+
+    async def swap_model(self, model: str) -> bool:
+        """
+        Load another model in the background and switch to it between two writes.
+        The old process gets EOF so it finalizes its last window, then exits.
+        """
+        if model == self.active_model:
+            return False
+        return await self._hot_swap(model, self.active_language)
+
+    async def set_language(self, language: str) -> bool:
+        """Restart decoding pinned to a language ("auto" detects again), same hand-over as a model swap"""
+        try:
+            if language == self.active_language:
+                return False
+            logger.info(f"🌐 [{self.stream_id}] Language {self.active_language} -> {language}")
+            return await self._hot_swap(self.active_model, language)
+        finally:
+            if self.language_tracker:
+                self.language_tracker.sync(self.active_language)
 
-            # Start ffmpeg process
-            self.ffmpeg_proc = await asyncio.create_subprocess_exec(
-                *ffmpeg_cmd,
-                stdout=asyncio.subprocess.PIPE,
-                stderr=asyncio.subprocess.PIPE
-            )
+    async def _hot_swap(self, model: str, language: str) -> bool:
+        if self._swapping or not self.running:
+            return False
+        self._swapping = True
+        try:
+            logger.info(f"🔁 [{self.stream_id}] Loading {model} ({language}) in the background...")
+            # whisper.cpp also goes quiet while it reads the tensors of a large model,
+            # so silence alone proves nothing; wait for the state it builds afterwards
+            activity = [time.perf_counter(), 0, False]
+            proc = await self._spawn_whisper(model, activity, language)
+            deadline = time.perf_counter() + self.config.model_load_timeout
+            while proc.returncode is None and time.perf_counter() < deadline:
+                await asyncio.sleep(0.25)
+                if activity[2] and time.perf_counter() - activity[0] > 0.5:
+                    break
 
-            # Start whisper process with ffmpeg stdout as stdin
-            self.whisper_proc = await asyncio.create_subprocess_exec(
-                *whisper_cmd,
-                stdin=self.ffmpeg_proc.stdout,
-                stdout=asyncio.subprocess.PIPE,
-                stderr=asyncio.subprocess.PIPE
-            )
+            if proc.returncode is not None or not activity[2] or not self.running:
+                reason = "exited" if proc.returncode is not None else "did not finish loading"
+                logger.error(f"❌ [{self.stream_id}] Could not load {model} ({reason}); "
+                             f"keeping {self.active_model}")
+                await self._terminate(proc)
+                return False
+
+            old, self.whisper_proc = self.whisper_proc, proc
+            self.active_model = model
+            self.active_language = language
+            logger.info(f"🔁 [{self.stream_id}] Switched to {model} ({language})")
+            if old:
+                self._retiring.add(old)
+                asyncio.create_task(self._retire(old))
+            return True
+        finally:
+            self._swapping = False
+
+    async def _retire(self, proc):
+        """Close a swapped-out whisper's input and give it time to flush its last window"""
+        try:
+            if not proc.stdin.is_closing():
+                proc.stdin.close()
+            await asyncio.wait_for(proc.wait(), timeout=10.0)
+        except asyncio.TimeoutError:
+            await self._terminate(proc)
+        except Exception:
+            pass
+        finally:
+            self._retiring.discard(proc)
+
+    async def _watch_realtime_factor(self):
+        """
+        Step down the model ladder when whisper cannot keep up. While the ring
+        backlog is growing, whisper is the bottleneck and the audio it consumed
+        over the window gives the real-time factor directly.
+        """
+        window = self.config.rtf_window_seconds
+        while self.running:
+            backlog_start = len(self.ring)
+            consumed_start = self.bytes_to_whisper
+            skipped_start = self.skipped_bytes
+            await asyncio.sleep(window)
+
+            # Audio skipped ahead still counts as backlog whisper could not absorb
+            backlog_end = len(self.ring) + self.skipped_bytes - skipped_start
+            consumed = self.bytes_to_whisper - consumed_start
+            if backlog_end < self.bytes_per_second or backlog_end < backlog_start:
+                self.measured_rtf = None
+                continue
+
+            self.measured_rtf = window * self.bytes_per_second / consumed if consumed else float('inf')
+            if self.measured_rtf <= self.config.rtf_downgrade_threshold:
+                continue
+
+            position = self.model_ladder.index(self.active_model) if self.active_model in self.model_ladder else 0
+            if position + 1 < len(self.model_ladder):
+                logger.warning(f"🐢 [{self.stream_id}] Real-time factor {self.measured_rtf:.2f} > "
+                               f"{self.config.rtf_downgrade_threshold}; downgrading model")
+                await self.swap_model(self.model_ladder[position + 1])
+
+    async def _run_capture(self):
+        """Keep an ffmpeg capture attached to the ring, restarting it whenever it exits"""
+        try:
+            while self.running:
+                ffmpeg_cmd = self._build_ffmpeg_cmd()
+                logger.info(f"  FFmpeg: {' '.join(ffmpeg_cmd)}")
+
+                drain = None
+                try:
+                    self.ffmpeg_proc = await asyncio.create_subprocess_exec(
+                        *ffmpeg_cmd,
+                        stdout=asyncio.subprocess.PIPE,
+                        stderr=asyncio.subprocess.PIPE
+                    )
+                    self._place(self.ffmpeg_proc, self.config.capture_cpus)
+                    drain = asyncio.create_task(self._drain_stderr(self.ffmpeg_proc.stderr, "ffmpeg"))
+                    await self._capture_reader()
+                except Exception as e:
+                    logger.error(f"Capture error: {e}")
+                finally:
+                    await self._terminate(self.ffmpeg_proc)
+                    self.ffmpeg_proc = None
+                    if drain:
+                        drain.cancel()
+
+                if self.running:
+                    self.capture_restarts += 1
+                    logger.warning(f"Capture stopped; reattaching in {self.config.capture_restart_delay}s "
+                                   f"(whisper model stays loaded)")
+                    await asyncio.sleep(self.config.capture_restart_delay)
+        finally:
+            self.ring.close()
 
-            # Process transcription output
-            await self._process_whisper_output()
+    @staticmethod
+    async def _terminate(proc):
+        """Terminate a child process and reap it, ignoring ones that already exited"""
+        if not proc:
+            return
+        try:
+            proc.terminate()
+            await proc.wait()
+        except:
+            pass
+
+    def _vad_filter(self) -> str:
+        """
+        ffmpeg silenceremove graph used as an energy VAD. Every pause longer than
+        vad_min_silence is cut, keeping vad_keep_silence of padding so utterances
+        stay separated at speech boundaries. Leading silence is treated as such a
+        pause rather than trimmed outright, so the first PCM still arrives right
+        after the device opens (the recording index takes its attach time from it).
+        """
+        c = self.config
+        return (f"silenceremove=detection=rms"
+                f":start_periods=0"
+                f":stop_periods=-1:stop_threshold={c.vad_threshold_db}dB"
+                f":stop_duration={c.vad_min_silence}:stop_silence={c.vad_keep_silence}")
+
+    async def _capture_reader(self):
+        """Producer: drain ffmpeg stdout into the ring buffer as fast as it arrives"""
+        frame_bytes = self.ring.frame_bytes
+        # A sample split across two reads is completed here instead of
+        # concatenating the reads, so no per-read buffer is built
+        carry = bytearray(frame_bytes)
+        carried = 0
+        try:
+            while self.running and self.ffmpeg_proc:
+                wait_start = time.perf_counter()
+                chunk = await self.ffmpeg_proc.stdout.read(self.config.audio_read_chunk_bytes)
+                self._observe_read_wait((time.perf_counter() - wait_start) * 1000)
+                if not chunk:
+                    logger.warning("No more audio from ffmpeg")
+                    break
 
+                if self.recorder and self.recorder.attached_at is None:
+                    self.recorder.mark_attached(self.bytes_to_ms(len(chunk)) / 1000.0)
+
+                view = memoryview(chunk)
+                dropped = 0
+                if carried:
+                    take = min(frame_bytes - carried, len(view))
+                    carry[carried:carried + take] = view[:take]
+                    carried += take
+                    view = view[take:]
+                    if carried == frame_bytes:
+                        dropped += self.ring.write(carry)
+                        carried = 0
+
+                aligned = len(view) - len(view) % frame_bytes
+                dropped += self.ring.write(view[:aligned])
+                if aligned < len(view):
+                    carried = len(view) - aligned
+                    carry[:carried] = view[aligned:]
+                self._last_audio_at = time.perf_counter()
+                self._tail_left = self.tail_bytes
+
+                self._observe_ring_depth(self.bytes_to_ms(len(self.ring)))
+                if dropped:
+                    logger.warning(f"⚠️ Audio ring overflow: dropped {self.bytes_to_ms(dropped):.0f}ms "
+                                   f"(total {self.bytes_to_ms(self.ring.overflow_bytes):.0f}ms)")
         except Exception as e:
-            logger.error(f"Pipeline error: {e}")
-            await self.stop_pipeline()
+            if self.running:
+                logger.error(f"Error reading audio from ffmpeg: {e}")
 
-    async def _process_whisper_output(self):
-        """Process real-time transcription output from whisper-stream-stdin"""
+    async def _whisper_writer(self):
+        """Consumer: feed buffered PCM to whisper-stream-stdin at whatever pace it reads"""
         try:
-            while self.running and self.whisper_proc:
+            while self.running:
+                if self.max_backlog_bytes and len(self.ring) > self.max_backlog_bytes:
+                    self._skip_ahead()
+                view = await self.ring.read(self.config.audio_read_chunk_bytes)
+                proc = self.whisper_proc
+                if view is None or not proc:
+                    break
+                try:
+                    # Re-read the process per chunk so a model swap takes effect between writes
+                    proc.stdin.write(view)
+                    self.bytes_to_whisper += len(view)
+                    wait_start = time.perf_counter()
+                    await proc.stdin.drain()
+                    self._observe_write_wait((time.perf_counter() - wait_start) * 1000)
+                except (BrokenPipeError, ConnectionResetError):
+                    if proc is self.whisper_proc:
+                        logger.warning("whisper-stream-stdin closed its input")
+                        break
+        except Exception as e:
+            if self.running:
+                logger.error(f"Error writing audio to whisper: {e}")
+        finally:
+            proc = self.whisper_proc
+            if proc and not proc.stdin.is_closing():
+                proc.stdin.close()
+
+    async def _feed_speech_tail(self):
+        """
+        The VAD gate cuts the audio when speech stops, which leaves whisper's
+        window without the input it needs to decode (and the stabilizer without
+        the repeat it needs to commit) the last words. Once capture goes quiet,
+        feed vad_tail_seconds of silence in real time; when whisper has had its
+        say on that, commit whatever is still tentative.
+        """
+        interval = 0.1
+        silence = memoryview(bytes(int(interval * self.bytes_per_second)))
+        while self.running:
+            await asyncio.sleep(interval)
+            now = time.perf_counter()
+            if len(self.ring) or now - self._last_audio_at < 2 * interval:
+                continue
+            if self._tail_left:
+                size = min(len(silence), self._tail_left)
+                self.ring.write(silence[:size])
+                self._tail_left -= size
+                if not self._tail_left:
+                    self._tail_done_at = now
+                continue
+            # Tail fed: flush once whisper has gone quiet on it
+            if ((self.stabilizer.tentative or self.stabilizer.pending)
+                    and now - max(self._last_output_at, self._tail_done_at) > 1.0):
+                logger.debug(f"🔚 [{self.stream_id}] Speech ended; committing the tentative tail")
+                await self._flush_utterance()
+
+    def _skip_ahead(self):
+        """Bound latency instead of falling further behind: jump to near-live audio"""
+        skipped = self.ring.skip(len(self.ring) - self.skip_to_bytes)
+        self.skipped_bytes += skipped
+        self.gaps += 1
+        logger.warning(f"⏭️ [{self.stream_id}] Whisper {self.bytes_to_ms(skipped + self.skip_to_bytes):.0f}ms "
+                       f"behind; skipped {self.bytes_to_ms(skipped):.0f}ms of audio")
+        if self.recorder:
+            self.recorder.add_gap(self.bytes_to_ms(skipped) / 1000.0)
+        if self.gap_callback:
+            self.gap_callback(self.stream_id, round(self.bytes_to_ms(skipped)))
+
+    async def _drain_stderr(self, stream: asyncio.StreamReader, name: str, activity: Optional[list] = None):
+        """Keep child stderr pipes empty so a full pipe can never block the child"""
+        try:
+            while True:
+                line = await stream.readline()
+                if not line:
+                    break
+                if activity is not None:
+                    # [last line time, line count, loaded] for load detection
+                    activity[0] = time.perf_counter()
+                    activity[1] += 1
+                    if self.WHISPER_READY.search(line):
+                        activity[2] = True
+                logger.debug(f"[{name}] {line.decode('utf-8', errors='replace').rstrip()}")
+        except Exception:
+            pass
+
+    def bytes_to_ms(self, n: int) -> float:
+        """Convert a PCM byte count to milliseconds of audio"""
+        return n * 1000.0 / self.bytes_per_second
+
+    def _parse_output_line(self, line: bytes) -> Optional[TranscriptSegment]:
+        """Decode one stdout line in the configured output format"""
+        text = line.decode('utf-8', errors='replace').strip()
+        if not text:
+            return None
+        if self.config.whisper_output_format == "ndjson":
+            try:
+                record = json.loads(text)
+                frame_type = record.get('type', 'segment')
+            except (json.JSONDecodeError, AttributeError):
+                logger.warning(f"Invalid NDJSON from whisper: {text}")
+                return None
+            # A malformed record is dropped; it must not end the output loop
+            # and with it the pipeline (which would reload the model)
+            try:
+                if frame_type == 'stats':
+                    self._record_stats(record)
+                    return None
+                if frame_type != 'segment':
+                    return None
+                return TranscriptSegment.from_record(record)
+            except ValueError as e:
+                logger.warning(f"Malformed {frame_type} record from whisper ({e}): {text}")
+                return None
+        return TranscriptSegment(text=text)
+
+    def _record_stats(self, record: Dict[str, Any]):
+        """Fold one per-step stats frame from whisper-stream-stdin into the histograms"""
+        stages = (("mel", "mel_ms"), ("encode", "encode_ms"),
+                  ("decode", "decode_ms"), ("first_token", "ttft_ms"))
+        values = [TranscriptSegment._field(record, field, (int, float)) for _, field in stages]
+        for (stage, _), value in zip(stages, values):
+            self.metrics.observe(stage, value, stream=self.stream_id)
+
+    async def _emit(self, text: str, speaker: Optional[str] = None, is_question: Optional[bool] = None):
+        await self.transcript_callback(text, self.stream_id, speaker, is_question)
+        if self.recorder:
+            self.recorder.add_segment(text, speaker)
+        label = f"{self.stream_id}/{speaker}" if speaker else self.stream_id
+        logger.info(f"📝 Real-time transcript [{label}]: {text}")
+
+    async def _flush_utterance(self):
+        """Commit what the stabilizer still holds (speech ended or stream closed)"""
+        remainder = self.stabilizer.flush()
+        if remainder:
+            await self._emit(remainder, self.last_segment.speaker if self.last_segment else None)
+
+    async def _process_whisper_output(self, proc):
+        """Process real-time transcription output from one whisper-stream-stdin process"""
+        try:
+            while self.running:
                 # Read line from whisper output
-                line = await self.whisper_proc.stdout.readline()
+                line = await proc.stdout.readline()
 
                 if not line:
-                    logger.warning("No more output from whisper")
+                    if proc is self.whisper_proc:
+                        logger.warning("No more output from whisper")
                     break
 
-                transcript = line.decode('utf-8').strip()
+                self._last_output_at = time.perf_counter()
+                segment = self._parse_output_line(line)
 
                 # Skip empty lines and common whisper artifacts
-                if transcript and transcript not in ['[BLANK_AUDIO]', '']:
-                    await self.transcript_callback(transcript)
-                    logger.info(f"📝 Real-time transcript: {transcript}")
+                if not segment or segment.text in ['[BLANK_AUDIO]', '']:
+                    continue
+
+                # Dropped before the stabilizer, so a loop can never be committed
+                reason = self.guard.check(segment) if self.guard else None
+                if reason:
+                    self.dropped_segments += 1
+                    logger.debug(f"🚮 Dropped segment [{self.stream_id}] ({reason}): {segment.text}")
+                    continue
+
+                self.last_segment = segment
+                if self.language_tracker and proc is self.whisper_proc and not self._swapping:
+                    switch = self.language_tracker.observe(segment)
+                    if switch:
+                        asyncio.create_task(self.set_language(switch))
+                if segment.encode_ms is not None:
+                    logger.debug(f"⏱️ Segment {segment.segment_id}: encode {segment.encode_ms:.0f}ms, "
+                                 f"decode {segment.decode_ms or 0:.0f}ms, logprob {segment.avg_logprob}")
+
+                # The tool's question flag only describes the whole segment text
+                flag = None
+                if segment.is_final is None:
+                    committed, tentative = self.stabilizer.update(segment.text)
+                elif segment.is_final:
+                    # The tool already decided this is stable
+                    committed, tentative = segment.text, ""
+                    flag = segment.is_question
+                else:
+                    committed, tentative = "", segment.text
+                    flag = segment.is_question
+
+                # Committed text first: it claims a pre-fired answer before a
+                # question in the tentative tail could replace the speculation
+                if committed:
+                    await self._emit(committed, segment.speaker, flag)
+                if tentative:
+                    logger.debug(f"… Tentative transcript: {tentative}")
+                    if self.tentative_callback:
+                        await self.tentative_callback(tentative, self.stream_id, flag)
+
+            await self._flush_utterance()
 
         except Exception as e:
             if self.running:
@@ -467,26 +2191,27 @@ class AudioPipeline:
     async def stop_pipeline(self):
         """Stop the audio pipeline"""
         self.running = False
-
-        # Stop whisper process first
-        if self.whisper_proc:
-            try:
-                self.whisper_proc.terminate()
-                await self.whisper_proc.wait()
-            except:
-                pass
-            self.whisper_proc = None
+        await self._teardown()
+
+    async def _teardown(self):
+        """Cancel relay tasks and stop both child processes"""
+        whisper_proc, self.whisper_proc = self.whisper_proc, None
+        ffmpeg_proc, self.ffmpeg_proc = self.ffmpeg_proc, None
+        self.ring.close()
+        for task in self._relay_tasks:
+            task.cancel()
+        self._relay_tasks = []
+
+        # Stop whisper process first, including any still flushing after a swap
+        await self._terminate(whisper_proc)
+        for proc in list(self._retiring):
+            await self._terminate(proc)
 
         # Stop ffmpeg process
-        if self.ffmpeg_proc:
-            try:
-                self.ffmpeg_proc.terminate()
-                await self.ffmpeg_proc.wait()
-            except:
-                pass
-            self.ffmpeg_proc = None
+        await self._terminate(ffmpeg_proc)
 
-        logger.info("🎙️ Audio pipeline stopped")
+        if whisper_proc or ffmpeg_proc:
+            logger.info(f"🎙️ Audio pipeline [{self.stream_id}] stopped")
 
 class NativeCognitiveEngine:
     """
@@ -498,16 +2223,48 @@ class NativeCognitiveEngine:
         self.config = config
         self.chronicler = Chronicler(config)
         self.advisor = Advisor(config, self.chronicler)
+        self.chronicler.summarizer = self.advisor.summarize
         self.frontend_server = FrontendWebSocketServer(config)
-        self.audio_pipeline = AudioPipeline(config)
+        self.metrics = PipelineMetrics()
+        # One pipeline per captured device; transcripts are tagged with its stream id
+        session_dir = None
+        if config.recording_dir:
+            session_dir = os.path.join(config.recording_dir, time.strftime("%Y%m%d-%H%M%S"))
+            logger.info(f"🔴 Recording session to {session_dir}")
+        self.audio_pipelines = [
+            AudioPipeline(config, stream_id, device, self.metrics,
+                          SessionRecorder(session_dir, stream_id, config.recording_chunk_seconds)
+                          if session_dir else None)
+            for stream_id, device in config.audio_streams()]
+        self.metrics_runner = None
+        self.frontend_server.control_handler = self._handle_control
+        for pipeline in self.audio_pipelines:
+            pipeline.gap_callback = self.frontend_server.broadcast_gap
         self.running = False
 
         self.stats = {
             "questions_processed": 0,
             "context_updates": 0,
             "transcripts_processed": 0,
+            "speculative_calls": 0,
+            "speculative_hits": 0,
             "average_response_time": 0.0
         }
+        # (question key, started at, Advisor task) for the in-flight speculative call
+        self._speculation: Optional[Tuple[str, float, asyncio.Task]] = None
+
+        self.metrics.counter("earshot_audio_dropped_ms_total", "Audio dropped on capture ring overflow",
+                             lambda: {p.stream_id: round(p.bytes_to_ms(p.ring.overflow_bytes))
+                                      for p in self.audio_pipelines})
+        self.metrics.counter("earshot_capture_restarts_total", "ffmpeg captures reattached to a running whisper",
+                             lambda: {p.stream_id: p.capture_restarts for p in self.audio_pipelines})
+        self.metrics.counter("earshot_audio_skipped_ms_total", "Audio skipped to bound transcription latency",
+                             lambda: {p.stream_id: round(p.bytes_to_ms(p.skipped_bytes)) for p in self.audio_pipelines})
+        self.metrics.counter("earshot_segments_dropped_total", "Segments dropped by the hallucination guard",
+                             lambda: {p.stream_id: p.dropped_segments for p in self.audio_pipelines})
+        self.metrics.counter("earshot_ws_dropped_total", "Frontend messages dropped or replaced in client queues",
+                             lambda: {"all": self.frontend_server.dropped_messages
+                                      + sum(c.dropped for c in self.frontend_server.clients.values())})
 
         logger.info("Native Cognitive Engine initialized")
 
@@ -516,12 +2273,32 @@ class NativeCognitiveEngine:
         self.running = True
         logger.info("🧠 Starting Native Cognitive Engine...")
 
+        # Keep the relay and Advisor off the compute cores whisper is pinned to
+        if self.config.capture_cpus:
+            # Children inherit the engine's affinity; without a compute list,
+            # whisper gets the cores the engine had, not the capture cores
+            if not self.config.compute_cpus:
+                self.config.compute_cpus = current_process_affinity()
+                if self.config.compute_cpus:
+                    logger.info(f"🔧 Compute cores (inherited): {self.config.compute_cpus}")
+            try:
+                apply_process_placement(os.getpid(), self.config.capture_cpus)
+            except Exception as e:
+                logger.warning(f"Could not pin engine to capture cores: {e}")
+
         # Start frontend WebSocket server
         await self.frontend_server.start_server()
 
+        if self.config.metrics_port:
+            await self._start_metrics_server()
+
         # Start background tasks
-        tasks = [
-            asyncio.create_task(self._run_audio_pipeline()),
+        tasks = [asyncio.create_task(self._run_audio_pipeline(pipeline))
+                 for pipeline in self.audio_pipelines]
+        if self.config.alloc_debug:
+            tasks.append(asyncio.create_task(self._alloc_monitor()))
+        tasks += [
+            asyncio.create_task(self.advisor.warm_up()),
             asyncio.create_task(self._chronicler_ticker()),
             asyncio.create_task(self._stats_reporter())
         ]
@@ -532,63 +2309,229 @@ class NativeCognitiveEngine:
             logger.info("Shutting down Native Cognitive Engine...")
             await self.shutdown()
 
-    async def _run_audio_pipeline(self):
-        """Run the audio pipeline with automatic restart on failure"""
+    async def _start_metrics_server(self):
+        """Serve per-stage latency histograms on /metrics in the Prometheus text format"""
+        async def handle_metrics(request):
+            return web.Response(text=self.metrics.render(), content_type="text/plain")
+
+        try:
+            app = web.Application()
+            app.router.add_get("/metrics", handle_metrics)
+            self.metrics_runner = web.AppRunner(app)
+            await self.metrics_runner.setup()
+            site = web.TCPSite(self.metrics_runner, self.config.frontend_ws_host, self.config.metrics_port)
+            await site.start()
+            logger.info(f"📈 Metrics available on http://{self.config.frontend_ws_host}:{self.config.metrics_port}/metrics")
+        except Exception as e:
+            logger.error(f"Failed to start metrics endpoint: {e}")
+
+    async def _handle_control(self, data: Dict[str, Any]):
+        """Frontend control message: {"type": "swap_model", "model": ..., "stream": "remote"}"""
+        stream_id = data.get('stream', 'remote')
+        model = data.get('model', '')
+        for pipeline in self.audio_pipelines:
+            if pipeline.stream_id != stream_id:
+                continue
+            # Only models from the configured ladder can be loaded, matched by path or file name
+            matches = [m for m in pipeline.model_ladder if model in (m, os.path.basename(m))]
+            if matches:
+                asyncio.create_task(pipeline.swap_model(matches[0]))
+            else:
+                logger.warning(f"Ignoring swap to unknown model: {model}")
+
+    async def _run_audio_pipeline(self, pipeline: AudioPipeline):
+        """Run one audio pipeline with automatic restart on failure"""
         while self.running:
             try:
-                await self.audio_pipeline.start_pipeline(self._process_transcript)
+                await pipeline.start_pipeline(self._process_transcript, self._process_tentative)
             except Exception as e:
                 logger.error(f"Audio pipeline failed: {e}")
-                if self.running:
-                    logger.info("Restarting audio pipeline in 5 seconds...")
-                    await asyncio.sleep(5)
-
-    async def _process_transcript(self, text: str):
-        """Process incoming transcript from audio pipeline"""
+            # Capture failures are recovered inside the pipeline; getting here means
+            # whisper itself exited, which requires a full model reload
+            if self.running:
+                logger.info(f"Restarting audio pipeline [{pipeline.stream_id}] in 5 seconds...")
+                await asyncio.sleep(5)
+
+    def _is_self(self, stream_id: str, speaker: Optional[str]) -> bool:
+        """True when the words came from our own user, whose questions need no answer"""
+        if stream_id == "local" and not self.config.answer_local_questions:
+            return True
+        return speaker is not None and speaker in self.config.self_speakers
+
+    async def _process_transcript(self, text: str, stream_id: str = "remote", speaker: Optional[str] = None,
+                                  is_question: Optional[bool] = None):
+        """Process incoming transcript from an audio pipeline"""
         if not text or not self.running:
             return
 
-        logger.info(f"🎤 Transcript: {text}")
+        logger.info(f"🎤 Transcript [{stream_id}{'/' + speaker if speaker else ''}]: {text}")
         self.stats["transcripts_processed"] += 1
+        self.frontend_server.broadcast_transcript(text, stream_id, speaker)
 
         # Add to chronicler for context
         if self.config.chronicler_enabled:
-            self.chronicler.add_transcription(text)
+            self.chronicler.add_transcription(text, stream_id=stream_id, speaker=speaker)
             self.stats["context_updates"] += 1
 
-        # Process with Advisor if it's a question
-        if self.advisor.is_question(text):
-            response = await self.advisor.process_text(text)
+        if self._is_self(stream_id, speaker):
+            return
+
+        # Process with Advisor if it's a question (classified once, here)
+        if self.advisor.is_question(text, is_question):
+            speculative = self._take_speculation(text)
+            if speculative:
+                self.stats["speculative_hits"] += 1
+                response = await speculative
+            else:
+                response = await self.advisor.process_text(text, classified=True)
+            self.metrics.observe("advisor", self.advisor.last_response_time * 1000, stream=stream_id)
             if response:
                 await self.frontend_server.broadcast_advisor_keywords(response)
                 self.stats["questions_processed"] += 1
 
+    @staticmethod
+    def _question_key(text: str) -> str:
+        return re.sub(r"[^\w]", "", text.lower())
+
+    async def _process_tentative(self, text: str, stream_id: str = "remote", is_question: Optional[bool] = None):
+        """
+        Show tentative text to subscribed clients and, with speculative_advisor,
+        pre-fire the Advisor on a tentative question so the LLM call overlaps
+        the commit delay
+        """
+        if not self.running:
+            return
+        self.frontend_server.broadcast_partial(text, stream_id)
+        if not self.config.speculative_advisor or self._is_self(stream_id, None):
+            return
+
+        # Tentative text repeats every step; an unchanged in-flight question needs no reclassification
+        key = self._question_key(text)
+        if self._speculation and self._speculation[0] == key:
+            return
+        if not self.advisor.is_question(text, is_question):
+            return
+        self._cancel_speculation()
+
+        logger.debug(f"⚡ Speculative Advisor call [{stream_id}]: {text}")
+        self._speculation = (key, time.time(),
+                             asyncio.create_task(self.advisor.process_text(text, classified=True)))
+        self.stats["speculative_calls"] += 1
+
+    def _take_speculation(self, text: str) -> Optional[asyncio.Task]:
+        """Hand over the speculative call if it was for this committed question, else cancel it"""
+        if not self._speculation:
+            return None
+        key, started, task = self._speculation
+        self._speculation = None
+
+        committed = self._question_key(text)
+        fresh = time.time() - started <= self.config.speculation_max_age
+        if fresh and key and (committed == key or committed.endswith(key)):
+            return task
+        task.cancel()
+        return None
+
+    def _cancel_speculation(self):
+        if self._speculation:
+            self._speculation[2].cancel()
+            self._speculation = None
+
     async def _chronicler_ticker(self):
-        """Context ticker: print current summary every 5 seconds"""
+        """Context ticker: print the context state every 5 seconds, only when it changed"""
         while self.running:
             await asyncio.sleep(5.0)
-            if self.running and self.config.chronicler_enabled:
+            if self.running and self.config.chronicler_enabled and self.chronicler.changed:
+                self.chronicler.changed = False
                 self.chronicler.debug_print_context()
 
+    # Per-chunk relay code; anything it allocated after warm-up and still holds is a leak
+    RELAY_FUNCTIONS = ("AudioPipeline._capture_reader", "AudioPipeline._whisper_writer",
+                       "PcmRingBuffer.write", "PcmRingBuffer.read", "PcmRingBuffer.skip",
+                       "LatencyHistogram.record")
+
+    async def _alloc_monitor(self):
+        """
+        Debug leak check: blocks allocated from the relay hot path since steady
+        state began that are still alive. It compares live snapshots, so it sees
+        growth, not the transient objects each chunk creates and frees (the
+        bytes from each read and the memoryview slices over it and the ring).
+        """
+        ranges = []
+        for name in self.RELAY_FUNCTIONS:
+            cls, attr = name.split(".")
+            lines, start = inspect.getsourcelines(getattr(globals()[cls], attr))
+            ranges.append((name, start, start + len(lines)))
+
+        def relay_frame(trace) -> Optional[str]:
+            for frame in trace:
+                if frame.filename == __file__:
+                    for name, start, end in ranges:
+                        if start <= frame.lineno < end:
+                            return f"{name}:{frame.lineno}"
+            return None
+
+        tracemalloc.start(8)
+        await asyncio.sleep(self.config.alloc_debug_warmup)
+        only_ours = [tracemalloc.Filter(True, __file__, all_frames=True)]
+        baseline = tracemalloc.take_snapshot().filter_traces(only_ours)
+        logger.info("🔬 Relay leak check: steady state baseline taken")
+        try:
+            while self.running:
+                await asyncio.sleep(30.0)
+                snapshot = tracemalloc.take_snapshot().filter_traces(only_ours)
+                growth: Dict[str, int] = {}
+                for stat in snapshot.compare_to(baseline, "traceback"):
+                    site = relay_frame(stat.traceback) if stat.count_diff > 0 else None
+                    if site:
+                        growth[site] = growth.get(site, 0) + stat.count_diff
+                if growth:
+                    top = ", ".join(f"{site} +{count}" for site, count in
+                                    sorted(growth.items(), key=lambda item: -item[1])[:3])
+                    logger.warning(f"🔬 Relay holds {sum(growth.values())} more live blocks than at "
+                                   f"steady state: {top}")
+                else:
+                    logger.info("🔬 Relay steady state: no live growth")
+        finally:
+            tracemalloc.stop()
+
     async def _stats_reporter(self):
         """Report system statistics"""
         while self.running:
             await asyncio.sleep(30.0)
             if self.running:
+                audio = ", ".join(
+                    f"{p.stream_id} {os.path.basename(p.active_model)} [{p.active_language}] "
+                    f"backlog {p.bytes_to_ms(len(p.ring)):.0f}ms "
+                    f"dropped {p.bytes_to_ms(p.ring.overflow_bytes):.0f}ms "
+                    f"skipped {p.bytes_to_ms(p.skipped_bytes):.0f}ms ({p.gaps} gaps)"
+                    + (f" rtf {p.measured_rtf:.2f}" if p.measured_rtf else "")
+                    for p in self.audio_pipelines)
                 logger.info(f"📊 Stats: {self.stats['transcripts_processed']} transcripts, "
-                          f"{self.stats['questions_processed']} questions, "
+                          f"{self.stats['questions_processed']} questions "
+                          f"({self.stats['speculative_hits']}/{self.stats['speculative_calls']} speculative hits), "
                           f"avg response: {self.advisor.last_response_time:.3f}s, "
+                          f"audio: {audio}, "
                           f"frontend clients: {len(self.frontend_server.clients)}")
 
     async def shutdown(self):
         """Clean shutdown of all components"""
         self.running = False
+        self._cancel_speculation()
+        self.chronicler.pause_summarization()
 
-        # Stop audio pipeline
-        await self.audio_pipeline.stop_pipeline()
+        # Stop audio pipelines
+        for pipeline in self.audio_pipelines:
+            await pipeline.stop_pipeline()
+            if pipeline.recorder:
+                pipeline.recorder.close()
 
         # Stop frontend server
         await self.frontend_server.stop_server()
+        await self.advisor.close()
+
+        if self.metrics_runner:
+            await self.metrics_runner.cleanup()
 
         logger.info("✅ Native Cognitive Engine shutdown complete")
 
@@ -601,6 +2544,8 @@ async def main():
                        help="Frontend WebSocket server port")
     parser.add_argument("--audio-device", default="CABLE Output (VB-Audio Virtual Cable)",
                        help="Audio input device name")
+    parser.add_argument("--mic-device", default=None,
+                       help="Optional local microphone device, transcribed as a separate stream")
     parser.add_argument("--whisper-model", default="./backend/whisper.cpp/models/for-tests-ggml-tiny.en.bin",
                        help="Path to Whisper model file")
     parser.add_argument("--ollama-host", default="127.0.0.1",
@@ -622,8 +2567,10 @@ async def main():
         frontend_ws_host=args.frontend_host,
         frontend_ws_port=args.frontend_port,
         audio_device=args.audio_device,
+        mic_device=args.mic_device,
         whisper_model=args.whisper_model
     )
+    config.prefer_quantized_models()
 
     # Start native cognitive engine
     engine = NativeCognitiveEngine(config)
@@ -0,0 +1,76 @@
+#!/usr/bin/env python3
+"""
+Unit tests for the sliding-window transcript stabilizer
+Run: python test_transcript_stabilizer.py
+"""
+
+import unittest
+
+from brain_native import TranscriptStabilizer
+
+def feed(stabilizer, hypotheses):
+    """Run hypotheses through the stabilizer; returns (utterances, last tentative)"""
+    utterances = []
+    tentative = ""
+    for text in hypotheses:
+        committed, tentative = stabilizer.update(text)
+        if committed:
+            utterances.append(committed)
+    return utterances, tentative
+
+class TranscriptStabilizerTest(unittest.TestCase):
+
+    def test_question_is_committed_as_one_utterance(self):
+        utterances, tentative = feed(TranscriptStabilizer(agreement_steps=2), [
+            "What is",
+            "What is the dead",
+            "What is the deadline for",
+            "What is the deadline for the project?",
+            "What is the deadline for the project?",
+        ])
+        self.assertEqual(utterances, ["What is the deadline for the project?"])
+        self.assertEqual(tentative, "")
+
+    def test_partial_shows_held_back_words(self):
+        stabilizer = TranscriptStabilizer(agreement_steps=2)
+        utterances, tentative = feed(stabilizer, ["What is", "What is the dead"])
+        self.assertEqual(utterances, [])
+        self.assertEqual(tentative, "What is the dead")
+
+    def test_split_at_sentence_boundary(self):
+        utterances, tentative = feed(TranscriptStabilizer(agreement_steps=2), [
+            "We ship on Friday. Does that",
+            "We ship on Friday. Does that work",
+        ])
+        self.assertEqual(utterances, ["We ship on Friday."])
+        self.assertEqual(tentative, "Does that work")
+
+    def test_unpunctuated_text_commits_when_tail_agrees(self):
+        utterances, _ = feed(TranscriptStabilizer(agreement_steps=2), [
+            "so the budget is fine",
+            "so the budget is fine",
+        ])
+        self.assertEqual(utterances, ["so the budget is fine"])
+
+    def test_committed_words_are_not_repeated(self):
+        utterances, _ = feed(TranscriptStabilizer(agreement_steps=2), [
+            "Hello there.",
+            "Hello there.",
+            "Hello there. How are you?",
+            "Hello there. How are you?",
+        ])
+        self.assertEqual(utterances, ["Hello there.", "How are you?"])
+
+    def test_flush_returns_pending_and_tentative(self):
+        stabilizer = TranscriptStabilizer(agreement_steps=2)
+        feed(stabilizer, ["What is", "What is the dead"])
+        self.assertEqual(stabilizer.flush(), "What is the dead")
+        self.assertEqual(stabilizer.flush(), "")
+
+    def test_single_step_commits_immediately(self):
+        utterances, tentative = feed(TranscriptStabilizer(agreement_steps=1), ["Good morning"])
+        self.assertEqual(utterances, ["Good morning"])
+        self.assertEqual(tentative, "")
+
+if __name__ == "__main__":
+    unittest.main()
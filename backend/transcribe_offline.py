@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""
+Offline bulk transcription for recorded meetings
+Splits a recording at silence boundaries, transcribes the chunks in parallel
+with whisper-stream-stdin (each chunk is decoded by its own ffmpeg and piped
+straight into its own whisper process, as fast as the hardware allows) and
+writes the stitched result in the engine's NDJSON segment format.
+"""
+
+import argparse
+import asyncio
+import json
+import os
+import re
+import sys
+import time
+from collections import deque
+from typing import Dict, List, Optional, Tuple
+
+from brain_native import AudioPipeline, CognitiveConfig, TranscriptStabilizer
+
+SILENCE_START = re.compile(rb"silence_start: (-?[\d.]+)")
+SILENCE_END = re.compile(rb"silence_end: (-?[\d.]+)")
+DURATION = re.compile(rb"Duration: (\d+):(\d+):([\d.]+)")
+
+async def find_silences(path: str, threshold_db: float, min_silence: float) -> Tuple[float, List[Tuple[float, float]]]:
+    """One decode pass with silencedetect; returns (duration, [(start, end), ...])"""
+    proc = await asyncio.create_subprocess_exec(
+        "ffmpeg", "-hide_banner", "-nostats", "-i", path,
+        "-af", f"silencedetect=noise={threshold_db}dB:d={min_silence}",
+        "-f", "null", "-",
+        stdout=asyncio.subprocess.DEVNULL,
+        stderr=asyncio.subprocess.PIPE
+    )
+    duration = 0.0
+    silences: List[Tuple[float, float]] = []
+    start = None
+    async for line in proc.stderr:
+        match = DURATION.search(line)
+        if match and not duration:
+            hours, minutes, seconds = match.groups()
+            duration = int(hours) * 3600 + int(minutes) * 60 + float(seconds)
+        match = SILENCE_START.search(line)
+        if match:
+            start = max(0.0, float(match.group(1)))
+        match = SILENCE_END.search(line)
+        if match and start is not None:
+            silences.append((start, float(match.group(1))))
+            start = None
+    await proc.wait()
+    if start is not None and duration:
+        silences.append((start, duration))
+    return duration, silences
+
+def plan_chunks(duration: float, silences: List[Tuple[float, float]],
+                target: float, max_chunk: float) -> List[Tuple[float, float]]:
+    """
+    Cut at the middle of a silence once a chunk reaches the target length, so no
+    word is split; force a cut every max_chunk when nobody pauses. Chunks that
+    lie entirely inside one silence are dropped.
+    """
+    cuts = [0.0]
+    for start, end in silences:
+        middle = (start + end) / 2
+        while middle - cuts[-1] > max_chunk:
+            cuts.append(cuts[-1] + max_chunk)
+        if middle - cuts[-1] >= target:
+            cuts.append(middle)
+    while duration - cuts[-1] > max_chunk:
+        cuts.append(cuts[-1] + max_chunk)
+    cuts.append(duration)
+
+    chunks = []
+    for begin, end in zip(cuts, cuts[1:]):
+        if end - begin < 0.1:
+            continue
+        if any(s <= begin and end <= e for s, e in silences):
+            continue
+        chunks.append((begin, end))
+    return chunks
+
+async def tail_stderr(stream: asyncio.StreamReader, lines: deque):
+    """Drain a child's stderr (so it never blocks on a full pipe), keeping the last lines"""
+    async for line in stream:
+        line = line.decode("utf-8", "replace").strip()
+        if line:
+            lines.append(line)
+
+def check_exit(name: str, proc, stderr: deque, begin: float, end: float):
+    if proc.returncode != 0:
+        detail = f": {stderr[-1]}" if stderr else ""
+        raise RuntimeError(f"chunk {begin:.1f}-{end:.1f}s: {name} exited with {proc.returncode}{detail}")
+
+async def transcribe_chunk(config: CognitiveConfig, path: str, begin: float, end: float) -> List[Dict]:
+    """
+    Decode one chunk with ffmpeg straight into whisper-stream-stdin and collect
+    its segments. Raises RuntimeError if either process fails, so a chunk is
+    never silently missing from the output.
+    """
+    ffmpeg = whisper = None
+    read_fd, write_fd = os.pipe()
+    try:
+        ffmpeg = await asyncio.create_subprocess_exec(
+            "ffmpeg", "-hide_banner", "-nostats", "-loglevel", "error",
+            "-ss", f"{begin:.3f}", "-t", f"{end - begin:.3f}", "-i", path,
+            "-ac", str(config.channels), "-ar", str(config.sample_rate),
+            "-acodec", "pcm_s16le", "-f", "s16le", "-",
+            stdout=write_fd,
+            stderr=asyncio.subprocess.PIPE
+        )
+        pipeline = AudioPipeline(config)
+        whisper = await asyncio.create_subprocess_exec(
+            *pipeline._build_whisper_cmd(),
+            stdin=read_fd,
+            stdout=asyncio.subprocess.PIPE,
+            stderr=asyncio.subprocess.PIPE
+        )
+    except BaseException:
+        if ffmpeg and ffmpeg.returncode is None:
+            ffmpeg.kill()
+        raise
+    finally:
+        # The children hold their own ends; whisper sees EOF when ffmpeg exits
+        os.close(read_fd)
+        os.close(write_fd)
+
+    ffmpeg_err: deque = deque(maxlen=5)
+    whisper_err: deque = deque(maxlen=5)
+    drains = [asyncio.create_task(tail_stderr(ffmpeg.stderr, ffmpeg_err)),
+              asyncio.create_task(tail_stderr(whisper.stderr, whisper_err))]
+
+    stabilizer = TranscriptStabilizer(config.transcript_agreement_steps)
+    segments: List[Dict] = []
+
+    def add(text: str, t0: Optional[float], t1: Optional[float], speaker: Optional[str] = None):
+        if not text:
+            return
+        segments.append({
+            "type": "segment",
+            "id": None,
+            "t0": round(begin + t0, 3) if t0 is not None else round(begin, 3),
+            "t1": round(begin + t1, 3) if t1 is not None else round(end, 3),
+            "is_final": True,
+            "text": text,
+            "speaker": speaker,
+        })
+
+    try:
+        while True:
+            line = await whisper.stdout.readline()
+            if not line:
+                break
+            segment = pipeline._parse_output_line(line)
+            if not segment or segment.text in ['[BLANK_AUDIO]', '']:
+                continue
+            if pipeline.guard and pipeline.guard.check(segment):
+                continue
+
+            if segment.is_final is None:
+                committed, _ = stabilizer.update(segment.text)
+                add(committed, None, None)
+            elif segment.is_final:
+                add(segment.text, segment.t0, segment.t1, segment.speaker)
+        add(stabilizer.flush(), None, None)
+
+        await whisper.wait()
+        await ffmpeg.wait()
+        await asyncio.gather(*drains)
+    finally:
+        for proc in (whisper, ffmpeg):
+            if proc.returncode is None:
+                proc.kill()
+                await proc.wait()
+        for drain in drains:
+            drain.cancel()
+
+    # whisper first: when it dies, ffmpeg only reports the broken pipe
+    check_exit("whisper-stream-stdin", whisper, whisper_err, begin, end)
+    check_exit("ffmpeg", ffmpeg, ffmpeg_err, begin, end)
+    return segments
+
+async def main():
+    parser = argparse.ArgumentParser(description="Transcribe a recorded meeting with parallel chunks")
+    parser.add_argument("input", help="Audio or video file readable by ffmpeg")
+    parser.add_argument("-o", "--output", help="NDJSON output file (default: stdout)")
+    parser.add_argument("--model", default=CognitiveConfig.whisper_model, help="Whisper model file")
+    parser.add_argument("--executable", default=CognitiveConfig.whisper_executable,
+                       help="Path to whisper-stream-stdin")
+    parser.add_argument("--jobs", type=int, default=max(1, (os.cpu_count() or 4) // 4),
+                       help="Chunks transcribed in parallel (one whisper process each)")
+    parser.add_argument("--threads", type=int, default=4, help="Whisper threads per job")
+    parser.add_argument("--language", help="Decode language (default: COPILOT_WHISPER_LANGUAGE, else "
+                       f"{CognitiveConfig.whisper_language})")
+    parser.add_argument("--output-format", choices=["text", "ndjson"], default="text",
+                       help="Tool output format; ndjson (if the build supports it) keeps per-segment timestamps")
+    parser.add_argument("--chunk-seconds", type=float, default=30.0,
+                       help="Target chunk length; cuts are placed in the next pause")
+    parser.add_argument("--max-chunk-seconds", type=float, default=60.0,
+                       help="Force a cut when nobody pauses for this long")
+    parser.add_argument("--silence-db", type=float, default=CognitiveConfig.vad_threshold_db,
+                       help="Silence threshold for chunk boundaries")
+
+    args = parser.parse_args()
+
+    config = CognitiveConfig(whisper_model=args.model, whisper_executable=args.executable,
+                             whisper_threads=args.threads)
+    # Set after construction: __post_init__ applies the COPILOT_* overrides, and
+    # an explicit flag has to win over the environment
+    config.whisper_output_format = args.output_format
+    if args.language:
+        config.whisper_language = args.language.lower()
+
+    started = time.perf_counter()
+    duration, silences = await find_silences(args.input, args.silence_db, config.vad_min_silence)
+    if not duration:
+        print(f"❌ Could not read {args.input}", file=sys.stderr)
+        return False
+    chunks = plan_chunks(duration, silences, args.chunk_seconds, args.max_chunk_seconds)
+    print(f"🚀 {args.input}: {duration:.0f}s audio, {len(chunks)} chunks, {args.jobs} jobs x "
+          f"{args.threads} threads", file=sys.stderr)
+
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+    semaphore = asyncio.Semaphore(args.jobs)
+
+    async def run(index: int, begin: float, end: float):
+        async with semaphore:
+            return index, await transcribe_chunk(config, args.input, begin, end)
+
+    # Chunks finish out of order; write them in order as soon as the next one is done
+    tasks = [asyncio.create_task(run(i, begin, end)) for i, (begin, end) in enumerate(chunks)]
+    done: Dict[int, List[Dict]] = {}
+    next_index = 0
+    segment_id = 0
+    try:
+        for finished in asyncio.as_completed(tasks):
+            index, segments = await finished
+            done[index] = segments
+            while next_index in done:
+                for segment in done.pop(next_index):
+                    segment["id"] = segment_id
+                    segment_id += 1
+                    out.write(json.dumps(segment, ensure_ascii=False) + "\n")
+                out.flush()
+                next_index += 1
+                print(f"   {next_index}/{len(chunks)} chunks", file=sys.stderr)
+    except Exception as e:
+        # A transcript with a hole in it is not a result; stop the other chunks
+        for task in tasks:
+            task.cancel()
+        await asyncio.gather(*tasks, return_exceptions=True)
+        print(f"❌ {e}", file=sys.stderr)
+        return False
+    finally:
+        if out is not sys.stdout:
+            out.close()
+
+    elapsed = time.perf_counter() - started
+    print(f"✅ {segment_id} segments in {elapsed:.1f}s "
+          f"({duration / elapsed:.1f}x real time)", file=sys.stderr)
+    return True
+
+if __name__ == "__main__":
+    ok = asyncio.run(main())
+    sys.exit(0 if ok else 1)
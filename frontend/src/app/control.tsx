@@ -91,6 +91,12 @@ export default function ControlPanel() {
         }
         console.log('Advisor response:', data.text);
         break;
+      case 'transcript':
+        // Transcripts are shown by the HUD; nothing to do in the control panel
+        break;
+      case 'gap':
+        // Transcription gaps only matter to the transcript view
+        break;
       default:
         console.log('Unknown message type:', data);
     }
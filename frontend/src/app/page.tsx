@@ -100,6 +100,10 @@ export default function ControlPanel() {
           });
         }
         break;
+      case 'gap':
+        // Whisper fell behind and the backend skipped audio; there is no transcript for it
+        console.warn(`Transcription gap on ${data.stream}: ${data.skipped_ms}ms skipped`);
+        break;
       default:
         console.log('Unknown message type:', data);
     }
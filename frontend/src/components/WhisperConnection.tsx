@@ -96,6 +96,10 @@ export function WhisperConnection({
         // This could be handled here or passed up to parent
         console.log('Advisor response received:', data.text);
         break;
+      case 'gap':
+        // Audio was skipped to catch up; the words before and after still arrive as transcripts
+        console.warn(`Transcription gap on ${data.stream}: ${data.skipped_ms}ms skipped`);
+        break;
       default:
         console.log('Unknown message type from backend:', data.type);
     }
@@ -1,10 +1,12 @@
 import { useEffect, useRef, useState, useCallback } from 'react';
 
 interface AdvisorMessage {
-  type: 'advisor_keywords' | 'status' | 'pong';
+  type: 'advisor_keywords' | 'status' | 'pong' | 'transcript' | 'gap';
   text?: string;
   status?: string;
   paused?: boolean;
+  stream?: string;
+  skipped_ms?: number;
   timestamp: number;
 }
 
@@ -144,6 +146,12 @@ export const useAdvisorStream = (wsUrl: string = 'ws://localhost:9082') => {
             case 'pong':
               // Pong received, connection is healthy
               break;
+            case 'transcript':
+              // Transcript text is handled by the HUD, not the advisor stream
+              break;
+            case 'gap':
+              // Skipped audio only affects the transcript, not advisor output
+              break;
             default:
               console.debug('Unknown message type:', message.type);
           }
@@ -5,12 +5,22 @@
 param(
     [switch]$Debug,
     [string]$Priority = "BelowNormal",
-    [int64]$AffinityMask = 0xFF0  # Use cores 4-11, leave 0-3 for OS/VS Code
+    [int64]$AffinityMask = 0xFF0,  # Use cores 4-11, leave 0-3 for OS/VS Code
+    [string]$ComputeCores = "",    # e.g. "6-11": whisper only (P-cores on hybrid CPUs)
+    [string]$CaptureCores = ""     # e.g. "4-5": ffmpeg + relay/Advisor (E-cores on hybrid CPUs)
 )
 
 Write-Host "🚀 Starting Earshot with Resource Optimization..." -ForegroundColor Green
 Write-Host "   Priority: $Priority" -ForegroundColor Yellow
 Write-Host "   CPU Affinity: 0x$($AffinityMask.ToString('X'))" -ForegroundColor Yellow
+if ($ComputeCores -or $CaptureCores) {
+    # One list alone would leave whisper on the cores the backend pins itself to
+    if (-not ($ComputeCores -and $CaptureCores)) {
+        Write-Host "❌ Error: -ComputeCores and -CaptureCores must be given together" -ForegroundColor Red
+        exit 1
+    }
+    Write-Host "   Compute cores: $ComputeCores  Capture cores: $CaptureCores" -ForegroundColor Yellow
+}
 
 # --- Cleanup trap for Ctrl+C ---
 $cleanup = {
@@ -101,6 +111,10 @@ if ($Debug) {
     $brainArgs += "--debug"
 }
 
+# Split the affinity mask between inference and capture inside the backend
+if ($ComputeCores) { $env:COPILOT_COMPUTE_CPUS = $ComputeCores }
+if ($CaptureCores) { $env:COPILOT_CAPTURE_CPUS = $CaptureCores }
+
 # Start the brain process
 $brainProc = Start-Process -FilePath $PythonExe -ArgumentList $brainArgs -PassThru -WindowStyle Hidden
 